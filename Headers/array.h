@@ -1,5 +1,5 @@
 /* Array-Generator by Isaac Jung
-Last updated 10/12/2022
+Last updated 10/16/2026
 
 |===========================================================================================================|
 |   This header contains classes for managing the array in an automated fashion. The Interaction and T      |
@@ -14,8 +14,17 @@ Last updated 10/12/2022
 
 #include "parser.h"
 #include "factor.h"
+#include "partition.h"
+#include "separation.h"
+#include "journal.h"
+#include "pool.h"
+#include "selector.h"
+#include "worklist.h"
+#include "rng.h"
+#include "scheduler.h"
+#include <ctime>
 #include <map>
-#include <mutex>
+#include <unordered_map>
 
 class T;    // forward declaration because Interaction and T have circular references
 
@@ -25,12 +34,19 @@ class Interaction
         // used only in verbose mode, to have some id associated with the interaction
         int id;
 
+        // position of this Interaction in the Array's interactions vector, used to address flat data
+        uint64_t rank;
+
+        // sum of the levels of the factors of this Interaction's Singles; heuristic_all uses this to weigh
+        // the problems that a row would solve for those Singles
+        uint64_t weight;
+
         // the actual list of (factor, value) tuples
         std::vector<Single*> singles;
 
         // this tracks the set of tests (represented as row numbers) in which this interaction occurs;
         // this row coverage is vital to analyzing the array's properties
-        std::set<int> rows;
+        Bitset rows;
 
         // easy lookup bool to cut down on redundant checks
         bool is_covered;
@@ -39,10 +55,9 @@ class Interaction
         // relevant sets when a new row with this interaction is added
         std::set<T*> sets;  
 
-        // this tracks the set differences between the set of rows in which this Interaction occurs and the
-        // sets of rows in which relevant T sets this Interaction is not part of occur; that is, this is
-        // a field to map detection issues to their delta values
-        std::map<T*, int64_t> deltas;
+        // this tracks how many T sets this Interaction is not part of are still separated from it by fewer
+        // than δ rows; the separations themselves live in the Array's Separation store, indexed by rank
+        uint64_t deficits;
 
         // easy lookup bool to cut down on redundant checks
         bool is_detectable;
@@ -61,6 +76,12 @@ class T
         // used only in verbose mode, to have some id associated with the T set
         int id;
 
+        // position of this T set in the Array's sets vector, used to address flat per-T data
+        uint64_t rank;
+
+        // sum of the weights of this T set's Interactions (see Interaction::weight)
+        uint64_t weight;
+
         // for easier access to the singles themselves
         std::vector<Single*> singles;
 
@@ -69,14 +90,7 @@ class T
 
         // each interaction in a given T set has its own version of this; the ρ associated with a T is simply
         // the union of the ρ's for each interaction in that T
-        std::set<int> rows;
-
-        // this tracks all the T sets which occur in the same set of rows as this instance; when adding a
-        // row to the array, each T set occurring in the row must be compared to every other T set to see
-        // if their sets of rows are disjoint yet; if so, there is no longer a conflict; when the size of
-        // "location_conflicts" becomes 0 while the above set, "rows", is greater than 0, this T becomes
-        // locatable within the array
-        std::set<T*> location_conflicts;
+        Bitset rows;
 
         // easy lookup bool to cut down on redundant checks
         bool is_locatable;
@@ -86,6 +100,80 @@ class T
         T(std::vector<Interaction*> *temp); // constructor with a premade vector of Interaction pointers
 };
 
+// scratch space for evaluating a row without changing the Array; each thread scoring rows needs its own
+class Workspace
+{
+    public:
+        std::vector<int> row;           // the candidate row being evaluated
+        std::vector<Interaction*> row_interactions; // Interactions occurring in the row being evaluated
+        std::vector<T*> row_sets;       // T sets occurring in that row, each appearing once
+        Bitset row_set_ranks;           // bits set for the ranks of those T sets
+        std::vector<uint64_t> class_counts;     // per location class, how many of those T sets are in it
+        std::vector<uint64_t> class_weights;    // per location class, total weight of those T sets in it
+        std::vector<uint64_t> touched;  // location classes with a nonzero count
+
+        // the best candidate rows this thread has found among the subtrees of heuristic_all's search it took
+        Selector selector;
+
+        // the best candidate rows of the subtree being searched; only these, and not what other threads have
+        // found, decide what is pruned in it, so that the search of a subtree never depends on the others
+        Selector found;
+
+        // for each depth of heuristic_all's search, the gain and offset of each value of that depth's column
+        std::vector<std::pair<uint64_t, uint64_t>> branches;
+
+        // heuristic_all's bounds given the columns assigned so far in the search (see prepare_bounds()), per
+        // tuple not yet completed and per column not yet assigned, and the old values of those changed, so
+        // that they can be put back when the search backs up
+        std::vector<uint64_t> tuple_bounds;
+        std::vector<uint64_t> column_bounds;
+        std::vector<std::pair<uint64_t*, uint64_t>> trail;
+        std::vector<uint64_t> fresh_bounds; // per value, a tuple bound being recomputed
+        uint64_t work = 0;  // Interactions and T sets looked at by this thread (see Array::total_work())
+        uint64_t limit;     // value of work at which the subtree being searched is stopped
+        bool cut;           // whether the subtree was stopped there before it was searched through
+        bool probing;       // whether only the first row of the subtree is wanted (see heuristic_all())
+        int64_t probe;      // score of that row
+};
+
+// a partial array considered by beam_search(): rows that could be added next, in order
+class BeamEntry
+{
+    public:
+        std::vector<int*> rows; // freed by beam_search() once it has chosen
+        int64_t gain;           // total of score_row() for each row, with the rows before it added
+};
+
+// a copy of the array's rows as plain cells, for anneal(); keeps just enough bookkeeping to tell how far the
+// rows are from having every property asked for, and to keep that up to date as single cells change
+class AnnealState
+{
+    public:
+        uint64_t num_rows;
+        std::vector<int> cells;             // row i occupies positions [i*num_factors, (i+1)*num_factors)
+        std::vector<uint64_t> occurrences;  // per Interaction, how many rows it occurs in
+        Worklist missing;                   // Interactions occurring in no rows
+
+        // per row, a random key, and per T set, the XOR of the keys of the rows it occurs in, so that T sets
+        // occurring in the same rows have the same hash (0 for those occurring in none); T sets per hash
+        std::vector<uint64_t> row_keys;
+        std::vector<uint64_t> set_hashes;
+        std::unordered_map<uint64_t, uint64_t> hash_counts;
+
+        // per Interaction, then per T set, the exact separation (huge for T sets containing the Interaction)
+        std::vector<uint32_t> separations;
+
+        // per T set, the last move in which it was found in the row changed, and in which it changed
+        std::vector<uint64_t> in_row;
+        std::vector<uint64_t> changed;
+        uint64_t move;
+
+        uint64_t coverage_cost;     // Interactions occurring in no rows
+        uint64_t location_cost;     // T sets occurring in no rows or in the same rows as another
+        uint64_t detection_cost;    // total shortfall of every separation below δ
+        uint64_t cost() const { return coverage_cost + location_cost + detection_cost; }
+};
+
 class Array
 {
     public:
@@ -119,23 +207,45 @@ class Array
         // list of all size-d sets of t-way interactions
         std::vector<T*> sets;
 
-        // really only needed by heuristic_all()
-        std::map<std::string, Single*> single_map;
+        // number of distinct size-t tuples of columns; each tuple owns a contiguous block of interactions
+        uint64_t num_tuples;
+
+        // rank (index into interactions) of the first Interaction belonging to each column tuple
+        std::vector<uint64_t> tuple_offsets;
+
+        // the t columns of each tuple, flattened; tuple i occupies positions [i*t, i*t + t)
+        std::vector<uint64_t> tuple_columns;
+
+        // mixed-radix place values of the columns above, flattened the same way; the rank of the Interaction
+        // a row has in tuple i is tuple_offsets[i] plus the sum of row[column]*radix over the tuple's columns
+        std::vector<uint64_t> tuple_radices;
+
+        // the tuples each column belongs to; column i owns the range [column_starts[i], column_starts[i+1])
+        // of column_tuples, and column_radices holds the place value of the column within each of them
+        std::vector<uint64_t> column_starts;
+        std::vector<uint64_t> column_tuples;
+        std::vector<uint64_t> column_radices;
 
-        // used by build_row_interactions()
-        std::map<std::string, Interaction*> interaction_map;
+        // the seed of rng, and which of the seed's streams it draws from, so that the array can be reproduced
+        uint64_t seed;
+        uint64_t stream;
 
-        // really only needed by heuristic_all()
-        std::map<std::string, T*> t_set_map;
+        // the number of rows given in the input file; they come first, and are never removed or changed
+        uint64_t fixed_rows;
 
+        uint64_t size() const { return num_tests; } // number of rows in the array so far
         void print_stats(bool initial = false); // prints current stats such as score
         void add_row();             // adds a row to the array based on scoring
+        void add_given_rows(Parser *in);    // adds the rows read from the input file
+        void add_ipog_rows();       // adds every row of a covering array built a column at a time
+        bool add_orthogonal_rows(); // adds the rows of an orthogonal array, when t is 2 and the levels allow it
+        void prune_rows(prune_order order);     // removes rows the finished array does not need
+        void anneal(uint64_t seconds);          // tries to find a valid array with fewer rows until time runs out
+        bool save_checkpoint(const std::string &path);  // writes what is needed to resume generating later
+        bool resume(const std::string &path);   // picks up generating from a checkpoint; call before any rows
         std::string to_string();    // returns a string representing all rows
         Array();    // default constructor, don't use this
-        Array(Parser *in);  // constructor with an initialized Parser object
-        Array(uint64_t total_problems, uint64_t coverage_problems, uint64_t location_problems,
-            uint64_t detection_problems, std::vector<int*> *rows, uint64_t num_tests, uint64_t num_factors,
-            Factor **factors, prop_mode p, uint64_t d, uint64_t t, uint64_t delta);
+        Array(Parser *in, uint64_t stream = 0); // constructor with an initialized Parser object
         ~Array();   // deconstructor
 
     private:
@@ -169,6 +279,9 @@ class Array
         // for dictating order of iteration; should be regularly shuffled
         int *permutation;
 
+        // where every random choice made while generating comes from; seeded by the constructor
+        Rng rng;
+
         // this makes the program print out data structures and program flow when enabled
         debug_mode debug;
 
@@ -184,45 +297,187 @@ class Array
         // this keeps track of what heuristic the program is currently using
         prop_mode heuristic_in_use;
 
-        // needed by heuristic_all_scorer to update scores in threads safely
-        std::mutex scores_mutex;
+        // how heuristic_c_only's rows are built; see density_row() for the alternative to the usual greedy way
+        engine_mode engine;
+
+        // another heuristic that builds the next row as well, to duel heuristic_in_use; none if there is no duel
+        prop_mode heuristic_challenging;
+
+        // measures what each heuristic achieves, so that update_heuristic() can pick the best one
+        Scheduler scheduler;
+
+        // the score and total_work() when add_row() started on the row being added, for the scheduler
+        uint64_t row_start_score;
+        uint64_t row_start_work;
+
+        // how many partial arrays beam_search() keeps, and how many rows ahead it looks; no search if width is 1
+        uint64_t beam_width;
+        uint64_t beam_depth;
+
+        // separation of every Interaction from every T set, saturating at δ; only built for detection
+        Separation separation;
+
+        // scratch space for update_scores(); has the bits set for the ranks of the T sets in the new row
+        Bitset row_set_ranks;
+
+        // groups T sets (by rank) into classes of T sets occurring in exactly the same rows; the T sets that
+        // share a class with a given T set are its location conflicts, so it becomes locatable once it has
+        // occurred and its class is down to just itself; class 0 holds the T sets that have never occurred
+        Partition location;
+
+        // total weight (see T::weight) of the T sets in each location class; used by heuristic_all
+        // capacity is reserved for one class per T set up front, so that the journal's pointers stay valid
+        std::vector<uint64_t> location_weights;
+
+        // the problems left to solve, by rank: Interactions not yet covered, T sets not yet locatable (filed
+        // under how many location conflicts they have), and Interactions not yet detectable (filed under δ
+        // minus their separation from the T set they are least separated from); these follow the kept rows
+        // only, which is safe because rows not kept must be rolled back before the next one is kept
+        Worklist uncovered;
+        Worklist unlocated;
+        Worklist undetectable;
+
+        // scratch space for heuristic_l_only(), one entry per Single by rank; all 0 between calls
+        std::vector<int64_t> single_scores;
+
+        // Singles whose issues changed since they were last filed in their Factor's queue; they are refiled
+        // just before the queues are used, so rows that were rolled back in between are accounted for too
+        std::vector<Single*> stale_singles;
+
+        // old values of everything changed by rows added with keep == false, so that they can be undone
+        Journal journal;
+
+        // how many rows at the end of the array were added with keep == false and are yet to be rolled back
+        uint64_t journaled_rows;
+
+        // in debug mode, the order of the location classes' members before the first of those rows, so that
+        // rollback() can check it puts them back in exactly that order
+        std::vector<uint64_t> trial_order;
+
+        // worker threads used by heuristic_all to score candidate rows in parallel
+        Pool *pool;
+
+        // per column tuple, the rank of the Interaction that the row being tweaked by heuristic_c_only has in
+        // it; changing one cell of the row only changes the entries of the tuples containing that column
+        std::vector<uint64_t> view;
+
+        // scratch space for evaluating rows, one per worker in the pool
+        std::vector<Workspace> workspaces;
+
+        // per Interaction, an upper bound on what a row containing it can gain from it and what it brings
+        // along; set by prepare_bounds() before each search of heuristic_all
+        std::vector<uint64_t> gains;
+
+        // per column, its depth in heuristic_all's search, i.e., its position in permutation order
+        std::vector<uint64_t> depth_of;
+
+        // per tuple, the depth at which it is completed (that of its last column in permutation order), and
+        // the position within the tuple of that column
+        std::vector<uint64_t> tuple_depths;
+        std::vector<uint64_t> tuple_lasts;
+
+        // the column tuples, grouped by the depth in heuristic_all's search at which they are completed;
+        // depth i owns the range [depth_starts[i], depth_starts[i+1]) of depth_tuples
+        std::vector<uint64_t> depth_starts;
+        std::vector<uint64_t> depth_tuples;
+
+        // the tuple and column bounds (see Workspace) before any column is assigned; tuple i owns the range
+        // starting at bound_offsets[i], with one entry per value of its last column
+        std::vector<uint64_t> bound_offsets;
+        std::vector<uint64_t> root_tuple_bounds;
+        std::vector<uint64_t> root_column_bounds;
+
+        // the largest level of any factor
+        uint64_t max_level;
+
+        // for prune_rows(): a random key per row, and per T set (by rank), the XOR of the keys of its rows, so
+        // that T sets occurring in the same rows have the same hash; the T sets with each hash are listed
+        std::vector<uint64_t> row_keys;
+        std::vector<uint64_t> set_hashes;
+        std::unordered_map<uint64_t, std::vector<T*>> hashed_sets;
+
+        // scratch space for is_redundant(); has the bits set for the ranks of the T sets already checked
+        Bitset checked_set_ranks;
+
+        // a score that heuristic_all's search knows, before it starts, the rows it keeps will reach
+        int64_t incumbent;
+
+        // work (see total_work()) heuristic_all's search may do per row before taking the best rows found so far
+        uint64_t search_work;
+
+        // Interactions and T sets looked at by the main thread while building rows; the workers keep their own
+        uint64_t work;
 
         // this utility method is called in the constructor to fill out the vector of all interactions
         // almost certainly needs to be recursive in order to handle arbitrary values of t
-        void build_t_way_interactions(uint64_t start, uint64_t t_cur, std::vector<Single*> *singles_so_far);
+        void build_t_way_interactions(uint64_t start, uint64_t t_cur, std::vector<uint64_t> *columns_so_far);
 
         // after the above method completes, call this one to fill out the set of all size-d sets
         // almost certainly needs to be recursive in order to handle arbitrary values of d
         void build_size_d_sets(uint64_t start, uint64_t d_cur,
             std::vector<Interaction*> *interactions_so_far);
 
-        // this utility method closely mimics the build_t_way_interactions() method, but uses the information
-        // from a given row to fill out a set of interactions representing those that appear in the row
-        void build_row_interactions(int *row, std::set<Interaction*> *row_interactions,
-            uint64_t start, uint64_t t_cur, std::string key);
+        // this utility method uses the information from a given row to fill out a list of interactions
+        // representing those that appear in the row; the list is cleared first, so it can be reused
+        void build_row_interactions(int *row, std::vector<Interaction*> *row_interactions);
 
+        // gets the rank of the Interaction that the given row has in the given column tuple
+        uint64_t interaction_rank(int *row, uint64_t tuple);
+
+        int *initialize_row(T **locked, Interaction **planted); // returns a row initialized for heuristic_in_use
         int *initialize_row_R();            // returns a randomly generated row
         int *initialize_row_S();            // returns a row initialized based on Singles
         int *initialize_row_T(T **locked);  // returns a row initialized based on T sets
-        int *initialize_row_I();            // returns a row initialized based on Interactions
+        int *initialize_row_I(Interaction **planted);   // returns a row initialized based on Interactions
+        int *density_row();                 // returns a row built one column at a time for coverage
         
-        void tweak_row(int *row, T *locked = nullptr);   // improves a decision for a row
+        // improves a decision for a row
+        void tweak_row(int *row, T *locked = nullptr, Interaction *planted = nullptr);
 
         void heuristic_c_only(int *row);
-        int heuristic_c_helper(int *row, std::set<Interaction*> *row_interactions, int *problems);
+        int heuristic_c_helper(int *row, uint64_t col, int from, int *problems, prop_mode *dont_cares_c);
+        void count_c_problems(Interaction *interaction, int sign, int *problems, prop_mode *dont_cares_c);
+        int64_t shift_view(uint64_t col, int from, int to);
         
         void heuristic_l_only(int *row, T *locked);
 
-        void heuristic_d_only(int *row);
-
-        void heuristic_all(int *row);
-        void heuristic_all_helper(int *row, uint64_t cur_col, std::map<int*, int64_t> *scores);
-        void heuristic_all_scorer(int *row, std::map<int*, int64_t> *scores);
+        void heuristic_d_only(int *row, Interaction *planted);
+        int *build_row();   // initializes and tweaks a row with heuristic_in_use
+        uint64_t score_after(int *row);     // what the score would be if the row was added
+        bool settle_duel(int *favorite_row, double favorite_work, int *challenger_row, double challenger_work);
+        void shuffle_permutation();
+
+        int *beam_search();
+        void build_candidates(uint64_t count, std::vector<int*> *candidates);
+
+        void heuristic_all(int *row, uint64_t keep = 1, std::vector<int*> *runners_up = nullptr);
+        void heuristic_all_helper(int *row, uint64_t depth, uint64_t gain, Workspace *ws);
+        void prepare_bounds();
+        uint64_t completed_gain(int *row, uint64_t depth);
+        void assign_bounds(int *row, uint64_t depth, Workspace *ws);
+        uint64_t remaining_bound(uint64_t depth, Workspace *ws);
+        int64_t score_row(int *row, Workspace *ws);
         
         void update_array(int *row, bool keep = true);
-        void update_scores(std::set<Interaction*> *row_interactions, std::set<T*> *row_sets);
+        void rollback();    // undoes every row added with keep == false, newest first
+        void update_scores(std::vector<Interaction*> *row_interactions, std::vector<T*> *row_sets);
+        void update_location(std::vector<T*> *row_sets);
+        void shift_l_issues(T *t_set, int64_t change);
+        void set_locatable(T *t_set);
+        void file_conflicts(T *t_set);  // refiles a T set in the unlocated worklist after its class changed
+        void mark_stale(Single *s);     // notes that a Single's issues changed
+        void file_singles();            // refiles every stale Single in its Factor's queue
+        uint64_t location_conflicts(T *t_set);  // number of other T sets occurring in exactly the same rows
         void update_dont_cares();
         void update_heuristic();
-
-        Array *clone(); // for getting a copy of this, including deep copying of object references
+        uint64_t total_work();  // Interactions and T sets looked at while building rows, by every thread
+        bool is_redundant(uint64_t bit, std::vector<Interaction*> *row_interactions, std::vector<T*> *row_sets);
+        void unhash_set(T *t_set);  // takes a T set out of hashed_sets
+        void renumber_rows(const std::vector<uint64_t> &new_bits); // moves every row to its new bit
+
+        void anneal_build(AnnealState *state);
+        void anneal_set(AnnealState *state, uint64_t row, uint64_t col, int value);
+        void anneal_rehash(AnnealState *state, T *t_set, uint64_t row);
+        void anneal_separate(AnnealState *state, uint64_t rank, T *t_set, bool more);
+        bool occurs(T *t_set, const int *row);  // whether any of the T set's Interactions are in the row
 };
\ No newline at end of file
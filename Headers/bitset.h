@@ -0,0 +1,66 @@
+/* Array-Generator by Isaac Jung
+Last updated 10/16/2026
+
+|===========================================================================================================|
+|   This header contains a class for tracking sets of rows. Singles, Interactions, and T sets all need to    |
+| know which rows of the array they occur in, and those sets only ever grow by the row being added, so they  |
+| are stored as packed bits rather than as trees of ints. Bit n is set when the owner occurs in row n. The   |
+| storage is a word-aligned array whose capacity doubles whenever a row beyond it is set, meaning that the   |
+| cost of growing is amortized over the rows added. Comparing two row sets or counting their difference is   |
+| then a matter of a few word-wide AND/ANDNOT operations and popcounts. The small accessors are defined in   |
+| this header so that they can be inlined into the hot loops of the Array class; the rest are in bitset.cpp. |
+|===========================================================================================================|
+*/
+
+#pragma once
+#ifndef BITSET
+#define BITSET
+
+#include <cstdint>
+
+class Bitset
+{
+    public:
+        // for iterating over the set bits (i.e., the rows) in increasing order
+        class iterator
+        {
+            public:
+                uint64_t operator*() const { return bit; }
+                iterator &operator++();
+                bool operator!=(const iterator &other) const { return bit != other.bit; }
+                iterator(const Bitset *b, uint64_t start);
+            private:
+                const Bitset *owner;
+                uint64_t bit;
+        };
+
+        bool test(uint64_t bit) const   // whether the given bit is set
+        {
+            return (bit >> 6) < num_words && (words[bit >> 6] >> (bit & 63) & 1) != 0;
+        }
+        void set(uint64_t bit);         // sets the given bit, growing the storage if needed
+        void reset(uint64_t bit);       // clears the given bit
+        void clear();                   // clears all bits, keeping the storage
+        uint64_t count() const { return num_bits; } // number of set bits
+        bool empty() const { return num_bits == 0; }
+        uint64_t count_andnot(const Bitset &other, uint64_t cap = UINT64_MAX) const;   // |this \ other|
+        bool same_as(const Bitset &other) const;    // whether both have exactly the same bits set
+        void unite(const Bitset &other);            // sets every bit that is set in other
+        uint64_t capacity() const { return num_words << 6; }
+        const uint64_t *data() const { return words; }
+        uint64_t size_in_words() const { return num_words; }
+        iterator begin() const { return iterator(this, 0); }
+        iterator end() const { return iterator(this, UINT64_MAX); }
+        Bitset();                                   // default constructor, starts with no storage
+        Bitset(const Bitset &other);                // copy constructor
+        Bitset &operator=(const Bitset &other);     // copy assignment
+        ~Bitset();
+
+    private:
+        uint64_t *words;    // the packed bits, 64 per word
+        uint64_t num_words; // how many words are currently allocated
+        uint64_t num_bits;  // how many bits are set, cached so that count() is constant time
+        void grow(uint64_t min_words);  // reallocates to at least min_words, at least doubling the capacity
+};
+
+#endif // BITSET
@@ -0,0 +1,63 @@
+/* Array-Generator by Isaac Jung
+Last updated 10/16/2026
+
+|===========================================================================================================|
+|   This header contains classes for writing and reading the checkpoints of a long generation, so that it   |
+| can be resumed after being stopped. A checkpoint starts with a magic string and a format version, so that |
+| files of other kinds and of older formats are told apart, and ends with a 64-bit FNV-1a hash of           |
+| everything before it, so that a file cut short by a crash is refused rather than half read. Integers are  |
+| written as variable-length quantities, seven bits to a byte with the top bit set on every byte but the    |
+| last, so that the small numbers making up most of a checkpoint (cell values, counts, levels) take a byte  |
+| each whatever the machine. Doubles are written as the eight bytes of their bit pattern, lowest first.     |
+|   Only what cannot be worked out from the rows goes into a checkpoint: the rows themselves, the random    |
+| number generator, the order of iteration, what the scheduler has measured, and the order of the members   |
+| of each worklist, since a random member is picked by its place in its bucket and that order depends on    |
+| every row ever rolled back. Everything else the Array keeps (issue counts, which interactions are         |
+| covered, the location classes and the order of their members, separations) follows from the rows, since   |
+| rolling back a row puts even that order back (see partition.h), so a resumed Array gets it back by adding |
+| the rows again the usual way. This keeps checkpoints small, and keeps the format from having to change    |
+| whenever the bookkeeping does.                                                                            |
+|===========================================================================================================|
+*/
+
+#pragma once
+#ifndef CHECKPOINT
+#define CHECKPOINT
+
+#include <cstdint>
+#include <string>
+
+// builds up the bytes of a checkpoint in memory
+class Writer
+{
+    public:
+        std::string bytes;  // everything written so far
+
+        void integer(uint64_t value);
+        void real(double value);
+        void start();       // writes the magic string and version; write nothing before this
+        void finish();      // appends the hash; write nothing after this
+
+        static const char MAGIC[];          // what every checkpoint starts with
+        static const uint64_t VERSION = 2;  // of the format that follows the magic string
+};
+
+// reads the bytes of a checkpoint back in the order they were written
+class Reader
+{
+    public:
+        bool start();                   // reads the magic string and version; false unless both match
+        bool integer(uint64_t *value);  // false if the checkpoint ends first
+        bool real(double *value);       // false if the checkpoint ends first
+        bool intact() const;            // whether the hash at the end matches the rest
+        bool done() const { return position == end; }  // whether everything before the hash has been read
+
+        Reader(const std::string &bytes_o);
+
+    private:
+        const std::string &bytes;
+        uint64_t position;  // of the next byte to read
+        uint64_t end;       // position of the hash
+};
+
+#endif // CHECKPOINT
@@ -1,5 +1,5 @@
 /* Array-Generator by Isaac Jung
-Last updated 10/04/2022
+Last updated 10/16/2026
 
 |===========================================================================================================|
 |   This header contains classes used for organizing data associated with the Array class. There should be  |
@@ -23,6 +23,8 @@ Last updated 10/04/2022
 #define FACTOR
 
 #include "parser.h"
+#include "bitset.h"
+#include "worklist.h"
 #include <set>
 
 // basically just a tuple, but with a set of rows in which it occurs
@@ -34,7 +36,9 @@ class Single
         uint64_t d_issues;  // in how many detection issues does this Single appear
         uint64_t factor;    // represents the factor, or column of the array
         uint64_t value;     // represents the actual value of the factor
-        std::set<int> rows;         // tracks the set of rows in which this (factor, value) occurs
+        uint64_t rank;      // position in the Array's singles vector, used to address flat per-Single data
+        bool stale;         // whether its issues changed since it was last filed in its Factor's queue
+        Bitset rows;                // tracks the set of rows in which this (factor, value) occurs
         std::string to_string();    // returns a string representing the (factor, value)
         Single();                       // default constructor, don't use this
         Single(uint64_t f, uint64_t v); // constructor that takes the (factor, value)
@@ -50,6 +54,7 @@ class Factor
         uint64_t id;        // column number
         uint64_t level;     // number of values the column can take on
         Single **singles;   // pointer to array of Single pointers
+        SparseWorklist queue;   // values, filed under c_issues + l_issues + 3*d_issues of their Singles
         Factor();                                           // default constructor, don't use this
         Factor(uint64_t i, uint64_t l, Single **ptr_array); // constructor that takes id, level, Single*
         ~Factor();
@@ -0,0 +1,65 @@
+/* Array-Generator by Isaac Jung
+Last updated 10/16/2026
+
+|===========================================================================================================|
+|   This header contains a class for building a whole covering array a column at a time, in the way of the  |
+| IPOG (in-parameter-order general) strategy, rather than a row at a time like the Array does. The first t  |
+| columns start out with every combination of their values, one row each, which covers them exactly. Each   |
+| further column is then added in two steps. In the horizontal step, every row so far is given the value    |
+| for the new column that covers the most of the new column's uncovered interactions, i.e., those pairing   |
+| one of its values with values of t-1 earlier columns. In the vertical step, each interaction still        |
+| uncovered after that is put into the first row whose cells for it are don't cares or already agree with   |
+| it, or into a new row made of don't cares otherwise. The uncovered interactions of the new column are     |
+| kept as a bit-packed table, with one contiguous block of bits per set of t-1 earlier columns and the      |
+| value of the new column varying fastest, so each row only has to look at the C(k-1, t-1) blocks it can    |
+| touch, and never at interactions among earlier columns, which are all covered already. The don't cares    |
+| left at the end are for whoever uses the rows to fill in.                                                 |
+|===========================================================================================================|
+*/
+
+#pragma once
+#ifndef IPOG
+#define IPOG
+
+#include <cstdint>
+#include <vector>
+
+class Ipog
+{
+    public:
+        // the rows built so far, each with one cell per column; DONT_CARE marks cells no interaction needs
+        std::vector<std::vector<int>> rows;
+
+        void build();   // builds the rows for every column; call only once
+
+        Ipog();     // default constructor, don't use this
+        Ipog(const std::vector<uint64_t> &levels_o, uint64_t t_o);  // constructor with the levels of each column
+
+        static const int DONT_CARE = -1;
+
+    private:
+        std::vector<uint64_t> levels;   // levels of each column
+        uint64_t t;                     // strength of interactions
+
+        // the sets of t-1 columns before the column being added, in lexicographic order and flattened; set i
+        // occupies positions [i*(t-1), i*(t-1) + t-1)
+        std::vector<uint64_t> subsets;
+
+        // per set above, the position of its first bit in uncovered, plus one past the end of the last set
+        std::vector<uint64_t> offsets;
+
+        // a bit per interaction of the column being added, set while it is uncovered; see the description above
+        std::vector<uint64_t> uncovered;
+
+        std::vector<uint64_t> counts;   // per value of the column being added, scratch for counting interactions
+
+        void open_column(uint64_t col);
+        void grow_horizontally(uint64_t col);
+        void grow_vertically(uint64_t col);
+        uint64_t block(const std::vector<int> &row, uint64_t subset, uint64_t col);
+        void cover(const std::vector<int> &row, uint64_t col);
+        bool test(uint64_t bit) const { return (uncovered[bit >> 6] >> (bit & 63)) & 1; }
+        void clear(uint64_t bit) { uncovered[bit >> 6] &= ~(uint64_t{1} << (bit & 63)); }
+};
+
+#endif // IPOG
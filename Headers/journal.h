@@ -0,0 +1,52 @@
+/* Array-Generator by Isaac Jung
+Last updated 10/16/2026
+
+|===========================================================================================================|
+|   This header contains a class for undoing changes made to the Array's bookkeeping. When a row is added   |
+| only to see what it would do, every counter, flag, and packed word that the row changes is first saved    |
+| here along with its old value, and every location class split (and mark) it causes is recorded too.       |
+| Rolling back is then a matter of writing the old values back in reverse order, so it costs time           |
+| proportional to the number of changes made rather than to the size of the Array. Signed counters are      |
+| saved through their unsigned counterparts, which is safe because the two always share a representation.   |
+| Saving does nothing unless the journal is recording, so the Array can call the save methods               |
+| unconditionally.                                                                                          |
+|===========================================================================================================|
+*/
+
+#pragma once
+#ifndef JOURNAL
+#define JOURNAL
+
+#include "partition.h"
+#include <utility>
+
+class Journal
+{
+    public:
+        // whether changes should currently be saved; the Array turns this on only for rows it will undo
+        bool recording;
+
+        // location class splits made while recording, in the order they were made
+        std::vector<Split> splits;
+
+        // location class members marked while recording, with the index each was moved from (see Partition)
+        std::vector<std::pair<uint64_t, uint64_t>> marks;
+
+        void save(uint64_t *field) { if (recording) counters.emplace_back(field, *field); }
+        void save(int64_t *field) { save(reinterpret_cast<uint64_t*>(field)); }
+        void save(bool *flag) { if (recording) flags.emplace_back(flag, *flag); }
+        void save_mark(uint64_t member, uint64_t from) { if (recording) marks.emplace_back(member, from); }
+
+        void restore(Partition *partition); // writes back every saved value, merges and unmarks, then clears
+        bool empty() const { return counters.empty() && flags.empty() && splits.empty() && marks.empty(); }
+        Journal();  // default constructor, starts out not recording
+
+    private:
+        // every saved counter or packed word, with the value it had when saved
+        std::vector<std::pair<uint64_t*, uint64_t>> counters;
+
+        // every saved flag, with the value it had when saved
+        std::vector<std::pair<bool*, bool>> flags;
+};
+
+#endif // JOURNAL
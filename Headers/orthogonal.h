@@ -0,0 +1,52 @@
+/* Array-Generator by Isaac Jung
+Last updated 10/16/2026
+
+|===========================================================================================================|
+|   This header contains a class for building an orthogonal array of strength 2 in closed form, for seeding |
+| the Array before any row has to be scored. When q is a prime power p^m, there is a finite field GF(q)     |
+| with q elements, and for any q+1 columns with q levels each, the q*q rows indexed by pairs (a, b) of      |
+| field elements, with a*x + b in the column of each element x and a in the last column, have every pair of |
+| values of every two columns in exactly one row: two different columns give two independent linear         |
+| equations in a and b. Elements of GF(q) are written as polynomials of degree less than m over the         |
+| integers mod p, with the coefficients as the base-p digits of the element; adding adds the digits mod p,  |
+| and multiplying multiplies the polynomials and takes the remainder by a monic polynomial of degree m that |
+| has no factors. That polynomial is found by trying each in turn until one leaves no two nonzero elements  |
+| with a product of 0. Both operations are worked out for every pair of elements once, into tables, since   |
+| q*q rows need about that many of them anyway.                                                             |
+|===========================================================================================================|
+*/
+
+#pragma once
+#ifndef ORTHOGONAL
+#define ORTHOGONAL
+
+#include <cstdint>
+#include <vector>
+
+class Orthogonal
+{
+    public:
+        // the q*q rows built, each with q+1 cells whose values are from 0 to q-1
+        std::vector<std::vector<int>> rows;
+
+        void build();   // builds the rows; call only once
+
+        Orthogonal();               // default constructor, don't use this
+        Orthogonal(uint64_t q_o);   // constructor with the number of levels; must be a prime power
+
+        static bool is_prime_power(uint64_t n);
+
+    private:
+        uint64_t q; // number of elements of the field, p^m
+        uint64_t p; // characteristic of the field, a prime
+        uint64_t m; // number of base-p digits of each element
+
+        // the sum and product of every pair of elements; the result for (x, y) is at x*q + y
+        std::vector<uint64_t> sums;
+        std::vector<uint64_t> products;
+
+        void build_tables();
+        bool try_modulus(const std::vector<uint64_t> &modulus);
+};
+
+#endif // ORTHOGONAL
@@ -1,5 +1,5 @@
 /* Array-Generator by Isaac Jung
-Last updated 09/20/2022
+Last updated 10/16/2026
 
 |===========================================================================================================|
 |   This header contains a class used for processing input. Should the input format change, this class can  |
@@ -67,6 +67,28 @@ typedef enum {
     all     = 7
 } prop_mode;
 
+// typedef representing how rows for coverage are built
+// - greedy starts from the Singles with the most issues and tweaks the row until no change helps
+// - density fixes one column at a time to the value that covers the most Interactions in expectation
+// - ipog builds the whole covering array a column at a time instead of a row at a time (see ipog.h)
+typedef enum {
+    greedy  = 0,
+    density = 1,
+    ipog    = 2
+} engine_mode;
+
+// typedef representing whether redundant rows are removed once the array is finished, and in what order
+// - prune_off keeps every row
+// - prune_oldest tries the rows from first added to last added
+// - prune_newest tries the rows from last added to first added
+// - prune_random tries the rows in a random order
+typedef enum {
+    prune_off       = 0,
+    prune_oldest    = 1,
+    prune_newest    = 2,
+    prune_random    = 3
+} prune_order;
+
 class Parser
 {
     public:
@@ -83,6 +105,22 @@ class Parser
         out_mode o;         // output mode, normal by default
         prop_mode p;        // properties mode, all by default
 
+        // options
+        uint64_t threads;   // workers used to score candidate rows, 0 (meaning one per core) by default
+        uint64_t beam;      // partial arrays kept by the beam search, 1 (meaning no search) by default
+        uint64_t depth;     // rows the beam search looks ahead, 1 by default
+        engine_mode engine; // how rows for coverage are built, greedy by default; ipog only if p is c_only
+        prune_order prune;  // order to try removing rows in once finished, prune_off (meaning none) by default
+        uint64_t anneal;    // seconds to spend annealing once finished, 0 (meaning none) by default
+        uint64_t search_work;   // heuristic_all's work per row, in millions (see README); 2000 by default
+        uint64_t row_price;     // work one more row is considered to cost, in millions (see README); 6000 by default
+        uint64_t portfolio; // arrays generated at once with different streams, keeping the smallest; 1 by default
+        uint64_t seed;      // where all random choices follow from, the time of the run by default
+        std::string checkpoint;         // where to save checkpoints, none by default
+        uint64_t checkpoint_rows;       // rows between checkpoints, 0 (meaning not by rows) by default
+        uint64_t checkpoint_seconds;    // seconds between checkpoints, 600 if neither this nor the above is given
+        std::string resume;             // checkpoint to resume generating from, none by default
+
         // array stuff
         uint64_t num_rows = 0;          // rows, or tests, in the array
         uint64_t num_cols = 0;          // columns, or factors, in the array
@@ -0,0 +1,74 @@
+/* Array-Generator by Isaac Jung
+Last updated 10/16/2026
+
+|===========================================================================================================|
+|   This header contains a class for maintaining a partition of the numbers 0 to n-1 into classes, refined  |
+| one step at a time. The Array uses it to group T sets (by their rank) into classes of T sets that occur   |
+| in exactly the same rows; two T sets are in a location conflict exactly when they share a class. Adding a |
+| row to the array splits every class into the members that occur in the new row and the members that do    |
+| not. To do this, the caller marks each member occurring in the row and then calls refine(). Members of a  |
+| class are kept contiguous in a single array, and marking moves a member to the front of its class, so a   |
+| refinement step costs time proportional to the number of members marked, not to the size of the classes.  |
+| When a class is split, the unmarked members keep the old class id and the marked ones move to a new id.   |
+| This means that the class every member starts in (id 0) keeps holding whichever members have never been   |
+| marked at all. A split can be undone with merge(), as long as splits are undone in reverse order; since   |
+| marking moves members around, the marks can then be undone with unmark() in reverse order too, which puts |
+| every member back where it was, so the order members are visited in is exactly as before.                 |
+|===========================================================================================================|
+*/
+
+#pragma once
+#ifndef PARTITION
+#define PARTITION
+
+#include <cstdint>
+#include <vector>
+
+// describes what one call to refine() did to one class that had members marked
+class Split
+{
+    public:
+        uint64_t marked;    // class id now holding the marked members
+        uint64_t unmarked;  // class id still holding the unmarked members, or NO_CLASS if all were marked
+        uint64_t num_marked;    // how many members were marked
+        uint64_t size;          // how many members the class had before the split
+        static const uint64_t NO_CLASS = UINT64_MAX;
+};
+
+class Partition
+{
+    public:
+        // the members themselves, grouped so that every class occupies a contiguous range
+        std::vector<uint64_t> elements;
+
+        // for each member, the index at which it currently sits in elements
+        std::vector<uint64_t> position;
+
+        // for each member, the id of the class it currently belongs to
+        std::vector<uint64_t> class_of;
+
+        // for each class, the range [start, end) of elements that it occupies
+        std::vector<uint64_t> starts;
+        std::vector<uint64_t> ends;
+
+        uint64_t size_of(uint64_t c) const { return ends[c] - starts[c]; } // size of a class
+        uint64_t class_size(uint64_t member) const { return size_of(class_of[member]); }
+        uint64_t num_classes() const { return starts.size(); }
+
+        uint64_t mark(uint64_t member);             // marks a member for the next refine(); mark once only
+        void refine(std::vector<Split> *splits);    // splits every class with marked members
+        void merge(const Split &split);             // undoes a split; must undo in reverse order
+        void unmark(uint64_t member, uint64_t from);    // moves a member back once its split is merged
+
+        Partition();            // default constructor, holds no members
+        Partition(uint64_t n);  // constructor that puts members 0 to n-1 into a single class
+
+    private:
+        // for each class, how many of its members are marked; marked members sit at the front of the class
+        std::vector<uint64_t> marks;
+
+        // the classes that have at least one marked member
+        std::vector<uint64_t> touched;
+};
+
+#endif // PARTITION
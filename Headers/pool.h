@@ -0,0 +1,58 @@
+/* Array-Generator by Isaac Jung
+Last updated 10/16/2026
+
+|===========================================================================================================|
+|   This header contains a fixed-size pool of worker threads. The threads are started once, when the pool   |
+| is constructed, and sleep between uses, so handing them work costs a wakeup rather than a thread launch.  |
+| Work is given as a number of jobs and a function to call on each; run() hands out job numbers from a      |
+| shared counter, so a worker that finishes early simply takes the next job, and returns once every job is  |
+| done. The calling thread works through jobs too, as worker 0. Every call is also told which worker is      |
+| making it, so that callers can give each worker its own scratch space and results, meaning that no lock   |
+| is needed around the work itself.                                                                         |
+|===========================================================================================================|
+*/
+
+#pragma once
+#ifndef POOL
+#define POOL
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+class Pool
+{
+    public:
+        // a job, given its own number and the number of the worker doing it
+        typedef std::function<void(uint64_t job, uint64_t worker)> Job;
+
+        uint64_t size() const { return threads.size() + 1; }   // number of workers, counting the caller
+
+        void run(uint64_t num_jobs, const Job &job);    // does jobs 0 to num_jobs-1, returning when all are done
+
+        Pool();                     // default constructor, has no threads besides the caller
+        Pool(uint64_t num_workers); // constructor that starts num_workers-1 threads to help the caller
+        ~Pool();                    // deconstructor, stops and joins the threads
+
+    private:
+        std::vector<std::thread> threads;
+        std::mutex lock;
+        std::condition_variable wake;   // signalled when a new batch of jobs is ready, or when stopping
+        std::condition_variable done;   // signalled when the last busy thread finishes its part of a batch
+
+        const Job *work;                // what to do for the current batch
+        uint64_t num_jobs;              // size of the current batch
+        std::atomic<uint64_t> next;     // next job number to hand out
+        uint64_t busy;                  // threads yet to finish with the current batch
+        uint64_t batch;                 // counts batches, so that a thread can tell when a new one is ready
+        bool stopping;
+
+        void serve(uint64_t worker);    // loop run by each thread
+        void drain(uint64_t worker);    // takes and does jobs until none are left
+};
+
+#endif // POOL
@@ -0,0 +1,48 @@
+/* Array-Generator by Isaac Jung
+Last updated 10/16/2026
+
+|===========================================================================================================|
+|   This header contains a class for the random numbers used while generating an array. Every Array owns    |
+| one, seeded when the Array is made, rather than sharing the C library's rand(), so that several Arrays    |
+| can be generated at once in separate threads without disturbing each other's sequences, and so that the   |
+| seed behind any array is known. It can also be handed to the shuffles in <algorithm>.                     |
+|   The generator is xoshiro256** (Blackman and Vigna), which is fast, has a state of 256 bits, and passes  |
+| the usual statistical tests. Its state is filled from the seed by splitmix64, so that nearby seeds give   |
+| unrelated sequences. A seed can give many independent streams: jump() advances the state by 2^128         |
+| numbers, far more than any one stream will ever use, so the arrays of a portfolio each take a stream of   |
+| the same seed by jumping a different number of times. Values below some bound are drawn by rejecting the  |
+| few numbers that would make some values more likely than others, rather than by a plain modulus.          |
+|===========================================================================================================|
+*/
+
+#pragma once
+#ifndef RNG
+#define RNG
+
+#include <cstdint>
+
+class Writer;   // see checkpoint.h
+class Reader;
+
+class Rng
+{
+    public:
+        typedef uint64_t result_type;   // these three make it usable wherever <random> engines are
+        static constexpr result_type min() { return 0; }
+        static constexpr result_type max() { return UINT64_MAX; }
+        result_type operator()();       // the next number of the stream
+
+        uint64_t below(uint64_t n);     // a random value from 0 to n-1; n must not be 0
+        double unit() { return static_cast<double>((*this)() >> 11)/9007199254740992.0; }  // from [0, 1)
+        void seed(uint64_t s);          // starts the first stream of the given seed
+        void jump();                    // skips ahead to the next stream
+        void save(Writer *out) const;   // writes the state into a checkpoint
+        bool load(Reader *in);          // reads the state back; false if the checkpoint ends first
+        Rng();                          // default constructor, seeded with 0
+        Rng(uint64_t s);                // constructor with a seed
+
+    private:
+        uint64_t state[4];
+};
+
+#endif // RNG
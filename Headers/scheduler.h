@@ -0,0 +1,106 @@
+/* Array-Generator by Isaac Jung
+Last updated 10/16/2026
+
+|===========================================================================================================|
+|   This header contains a class for measuring how well each heuristic is doing, so that the Array can pick |
+| the one to use from what they actually achieve rather than from fixed thresholds. For every row a         |
+| heuristic builds, the scheduler is told what fraction of the Array's score the row took away (its gain),  |
+| and how much work building it took. Work is counted in Interactions and T sets looked at, which is where  |
+| nearly all of the time goes, so it tracks CPU time closely enough while coming out the same on every      |
+| machine and for any number of threads; this keeps every choice the scheduler makes reproducible from the  |
+| seed. One heuristic at a time is the favorite, and builds every row. Now and then, one of the others is   |
+| given the chance to build the same row from the same state, and the better of the two rows is kept; this  |
+| is called a duel. Heuristics are only ever compared through their duels, because every heuristic gains    |
+| less per row as the Array fills in, so rows built at different times say little about which heuristic is  |
+| better. A heuristic's efficiency is its gain divided by the work it did plus a price per row. The price   |
+| stands for the cost of making the array bigger; with it, a slow heuristic wins when its rows are enough   |
+| better to be worth the wait, and a fast one wins when its rows are nearly as good. A heuristic that has   |
+| been clearly more efficient than the favorite over its last few duels becomes the favorite itself. A      |
+| heuristic is due for another duel once the rows since its last duel have taken at least as much work as   |
+| its next row is expected to, so that dueling never takes up more than about half of the work done.        |
+| Building a row takes work roughly in proportion to the problems left, so that expectation is its average  |
+| row work scaled down by how much the score has dropped since its last duel. A heuristic whose rows are    |
+| that quick anyway may duel every row. So may every heuristic when the favorite's last row did not lower   |
+| the score at all; they then take turns until one takes over.                                              |
+|===========================================================================================================|
+*/
+
+#pragma once
+#ifndef SCHEDULER
+#define SCHEDULER
+
+#include "parser.h"
+#include <deque>
+#include <vector>
+
+class Writer;   // see checkpoint.h
+class Reader;
+
+// what one row built by a heuristic achieved
+class Sample
+{
+    public:
+        double gain;    // fraction of the Array's score that the row took (or would have taken) away
+        double work;    // work done building it (see Array::total_work())
+};
+
+// one row built by both a challenger and the favorite, from the same state
+class Duel
+{
+    public:
+        Sample challenger;
+        Sample favorite;
+};
+
+class Scheduler
+{
+    public:
+        // notes a row built by the favorite alone, given the Array's score before and after it was added
+        void record(prop_mode heuristic, uint64_t before, uint64_t after, double work);
+
+        // notes a row built by both the challenger and the favorite; each after is the score had its row been added
+        void duel(prop_mode challenger, uint64_t before, uint64_t challenger_after, double challenger_work,
+            uint64_t favorite_after, double favorite_work);
+
+        // picks the favorite for the next row out of the eligible heuristics, which must not be empty
+        prop_mode choose(const std::vector<prop_mode> &eligible, uint64_t score, prop_mode *challenger);
+
+        uint64_t samples(prop_mode heuristic) const { return windows[heuristic].size(); }  // rows remembered
+        double gain_per_row(prop_mode heuristic) const;     // over the rows remembered
+        double gain_per_work(prop_mode heuristic) const;    // over the rows remembered
+        double advantage(prop_mode heuristic) const;        // efficiency relative to the favorite, over duels
+
+        void save(Writer *out) const;   // writes everything measured into a checkpoint
+        bool load(Reader *in);          // reads it back; false if the checkpoint ends first or is damaged
+
+        Scheduler();    // default constructor, nothing measured yet
+
+        double row_price;   // work that one more row is considered to cost; not saved in checkpoints
+
+        static const uint64_t WINDOW = 8;       // rows remembered per heuristic
+        static const uint64_t DUELS = 4;        // duels remembered per challenger
+        static const double QUICK;              // work of dueling per row not worth holding back
+        static const double MARGIN;             // advantage a challenger needs to become the favorite
+
+    private:
+        static const uint64_t NUM_MODES = all + 1;  // one slot per prop_mode
+
+        std::deque<Sample> windows[NUM_MODES];  // the last WINDOW rows built by each heuristic, oldest first
+        double gains[NUM_MODES];        // total gain over each window
+        double spent[NUM_MODES];        // total work over each window
+
+        std::deque<Duel> matches[NUM_MODES];    // each challenger's last DUELS duels with the current favorite
+        uint64_t last_row[NUM_MODES];   // value of rows at each challenger's last duel
+        double last_elapsed[NUM_MODES]; // value of elapsed at each challenger's last duel
+        uint64_t last_score[NUM_MODES]; // the Array's score before each challenger's last duel
+
+        prop_mode favorite; // none until choose() is first called
+        bool stalled;       // whether the favorite's last row did not lower the score at all
+        uint64_t rows;      // times choose() has been called
+        double elapsed;     // work of every row built so far
+
+        bool due(prop_mode heuristic, uint64_t score) const;  // whether it is time for the heuristic to duel again
+        Sample add_sample(prop_mode heuristic, uint64_t before, uint64_t after, double work);
+};
+
+#endif // SCHEDULER
@@ -0,0 +1,58 @@
+/* Array-Generator by Isaac Jung
+Last updated 10/16/2026
+
+|===========================================================================================================|
+|   This header contains a class for picking the best few out of a stream of scored candidates, without     |
+| storing the stream. A Selector keeps at most a fixed number of candidates, sorted best first, so a new    |
+| candidate either loses to the last one right away or is slotted into place. Ties in score are broken by a |
+| random priority key, and the key is a hash of the candidate (its index, or the cells of the row it stands |
+| for) mixed with a salt chosen per search. This means that every candidate tied for a place has the same   |
+| chance of getting it (the same as sampling uniformly from among the ties), but also that the outcome      |
+| depends only on which candidates were offered, not on the order they were offered in. Several Selectors   |
+| can therefore each take part of the stream, in separate threads, and be merged at the end with exactly    |
+| the result one Selector would have had if it took the whole stream. A candidate offered as a row keeps a  |
+| copy of its cells, so that rows too many to number can still be told apart and handed back.               |
+|===========================================================================================================|
+*/
+
+#pragma once
+#ifndef SELECTOR
+#define SELECTOR
+
+#include <cstdint>
+#include <vector>
+
+// one candidate kept by a Selector
+class Candidate
+{
+    public:
+        int64_t score;  // higher is better
+        uint64_t key;   // random priority used to break ties in score; lower wins
+        uint64_t index; // identifies the candidate to whoever offered it; 0 if offered as a row
+        std::vector<int> cells; // the row, if offered as one
+};
+
+class Selector
+{
+    public:
+        void reset(uint64_t capacity, uint64_t salt);   // empties the Selector and sets how many to keep
+        bool offer(int64_t score, uint64_t index);      // considers a candidate; returns whether it was kept
+        bool offer(int64_t score, const int *row, uint64_t length); // same, for a candidate that is a row
+        void merge(const Selector &other);              // offers every candidate kept by another Selector
+
+        // lowest score that can still be kept; candidates scoring less can be skipped without offering them
+        int64_t threshold() const { return kept.size() < capacity ? INT64_MIN : kept.back().score; }
+
+        const std::vector<Candidate> &best() const { return kept; }    // the candidates kept, best first
+        Selector();     // default constructor, keeps one candidate
+
+    private:
+        uint64_t capacity;  // most candidates to keep
+        uint64_t salt;      // mixed into every key, so that ties are broken differently every search
+        std::vector<Candidate> kept;    // best first
+
+        bool admits(const Candidate &candidate) const;  // whether a candidate would be kept if offered
+        void keep(const Candidate &candidate);          // slots in a candidate that admits() allows
+};
+
+#endif // SELECTOR
@@ -0,0 +1,55 @@
+/* Array-Generator by Isaac Jung
+Last updated 10/16/2026
+
+|===========================================================================================================|
+|   This header contains a class for storing the separation between every Interaction and every T set, as  |
+| needed for detection. The separation of an Interaction from a T set it is not part of is the number of   |
+| rows in which the Interaction occurs but the T set does not. Detection only cares whether that number has |
+| reached δ, so each one is kept as a small counter that saturates at δ. The counters are packed into 64 bit |
+| words using the smallest power-of-two width that can hold δ, and every Interaction owns a contiguous run  |
+| of words indexed by T set rank. Memory is therefore predictable from the number of Interactions, the      |
+| number of T sets, and δ alone: I * ceil(|T| / (64 / width)) words. Counters that should never be compared |
+| (an Interaction against a T set containing it) are saturated up front, and so are the padding slots at    |
+| the end of each run, meaning that a word whose counters are all saturated can be skipped without looking  |
+| inside it.                                                                                                |
+|===========================================================================================================|
+*/
+
+#pragma once
+#ifndef SEPARATION
+#define SEPARATION
+
+#include "bitset.h"
+#include "journal.h"
+#include <vector>
+
+class Separation
+{
+    public:
+        // value at which every counter saturates; this is δ
+        uint64_t cap;
+
+        uint64_t get(uint64_t interaction, uint64_t t_set) const;   // current (saturated) separation
+        void saturate(uint64_t interaction, uint64_t t_set);        // sets a counter straight to the cap
+
+        // adds 1 to every unsaturated counter of an Interaction, except those of T sets whose bits are set in
+        // skip; returns how many counters changed, and through reached, how many of them hit the cap, and
+        // through lowest, the smallest counter afterwards; every word changed is saved in the journal first
+        uint64_t advance(uint64_t interaction, const Bitset &skip, uint64_t *reached, uint64_t *lowest,
+            Journal *journal);
+
+        uint64_t bytes() const { return words.size()*sizeof(uint64_t); }   // memory used by the counters
+        Separation();   // default constructor, stores nothing
+        Separation(uint64_t num_interactions, uint64_t num_sets, uint64_t delta);
+
+    private:
+        std::vector<uint64_t> words;    // all counters, one run of stride words per Interaction
+        uint64_t num_sets;  // number of counters per Interaction
+        uint64_t width;     // bits per counter; a power of 2
+        uint64_t per_word;  // counters per word
+        uint64_t stride;    // words per Interaction
+        uint64_t mask;      // the low width bits set
+        uint64_t full;      // a word with every counter at the cap
+};
+
+#endif // SEPARATION
@@ -0,0 +1,85 @@
+/* Array-Generator by Isaac Jung
+Last updated 10/16/2026
+
+|===========================================================================================================|
+|   This header contains a class for keeping track of the problems the Array has left to solve, so that a   |
+| row can be aimed at one of them without scanning everything the Array has ever had to solve. Members are  |
+| small integers (such as the rank of an Interaction or T set), and each present member is filed under a    |
+| key, which says how bad its problem is. Each key has a bucket of members, and every member knows where it |
+| sits in its bucket, so adding, removing, and refiling a member are all O(1); a member is removed by       |
+| moving the last member of its bucket into its place. Picking a uniformly random member with a given key   |
+| is O(1) as well. The largest key in use is found by walking down from the largest one ever used, which    |
+| is cheap in practice because the keys used here mostly shrink as the Array grows. Some keys are too large |
+| and far apart to give every possible key a bucket, so a SparseWorklist does the same job but keeps only   |
+| the buckets in use, in an ordered map; filing a member then costs O(log b) for b distinct keys in use,    |
+| and the largest key is always at hand.                                                                    |
+|===========================================================================================================|
+*/
+
+#pragma once
+#ifndef WORKLIST
+#define WORKLIST
+
+#include "rng.h"
+#include <cstdint>
+#include <map>
+#include <vector>
+
+class Writer;   // see checkpoint.h
+class Reader;
+
+class Worklist
+{
+    public:
+        void insert(uint64_t member, uint64_t key = 0); // adds a member, or refiles it if already present
+        void remove(uint64_t member);                   // removes a member; does nothing if it is absent
+        bool contains(uint64_t member) const { return key_of[member] != ABSENT; }
+        uint64_t size() const { return count; }         // number of members present
+        uint64_t top();                                 // largest key of any present member; 0 if empty
+        uint64_t random(uint64_t key, Rng *rng) const;  // a random member with the given key; must be one
+        void save(Writer *out) const;                   // writes the buckets, in order, into a checkpoint
+        bool load(Reader *in);                          // reads them back; false if they do not fit
+        Worklist();             // default constructor, can hold no members
+        Worklist(uint64_t n);   // constructor that adds members 0 to n-1, all with key 0
+
+        static const uint64_t ABSENT = UINT64_MAX;  // key_of[] value for members not present
+
+    private:
+        // the present members with each key, in no particular order
+        std::vector<std::vector<uint64_t>> buckets;
+
+        // for each possible member, its key (ABSENT if not present) and its index in its bucket
+        std::vector<uint64_t> key_of;
+        std::vector<uint64_t> position;
+
+        uint64_t count;     // number of members present
+        uint64_t highest;   // no bucket above this one has members
+};
+
+// same as a Worklist, except that only the keys in use have buckets
+class SparseWorklist
+{
+    public:
+        void insert(uint64_t member, uint64_t key = 0); // adds a member, or refiles it if already present
+        void remove(uint64_t member);                   // removes a member; does nothing if it is absent
+        bool contains(uint64_t member) const { return key_of[member] != Worklist::ABSENT; }
+        uint64_t size() const { return count; }         // number of members present
+        uint64_t top() const { return buckets.empty() ? 0 : buckets.rbegin()->first; } // 0 if empty
+        uint64_t random(uint64_t key, Rng *rng) const;  // a random member with the given key; must be one
+        void save(Writer *out) const;                   // writes the buckets, in order, into a checkpoint
+        bool load(Reader *in);                          // reads them back; false if they do not fit
+        SparseWorklist();               // default constructor, can hold no members
+        SparseWorklist(uint64_t n);     // constructor that adds members 0 to n-1, all with key 0
+
+    private:
+        // the present members with each key in use, in no particular order; empty buckets are erased
+        std::map<uint64_t, std::vector<uint64_t>> buckets;
+
+        // for each possible member, its key (Worklist::ABSENT if not present) and its index in its bucket
+        std::vector<uint64_t> key_of;
+        std::vector<uint64_t> position;
+
+        uint64_t count; // number of members present
+};
+
+#endif // WORKLIST
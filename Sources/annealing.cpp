@@ -0,0 +1,327 @@
+/* Array-Generator by Isaac Jung
+Last updated 10/16/2026
+
+|===========================================================================================================|
+|   This file contains definitions for methods belonging to the Array class which are declared in array.h.  |
+| Specifically, the methods for shrinking a finished array by simulated annealing are found here. The rows  |
+| are copied into an AnnealState (see array.h), a row is dropped, and single cells are changed at random    |
+| until the rows have every property asked for again, or time runs out. Every change that lowers the cost   |
+| is kept, and one that raises it is kept with a probability that shrinks the more it raises it and the     |
+| lower the temperature. The cost counts the Interactions missing, the T sets that cannot be located, and   |
+| how far every separation falls short of δ, and changing one cell only touches the Interactions of that    |
+| cell's row through its column and the T sets containing them, so the cost of a change is found without    |
+| looking at the rest of the array. Each time the cost reaches 0, the rows are the best array found so far, |
+| and another row is dropped.                                                                               |
+|===========================================================================================================|
+*/
+
+#include "array.h"
+#include <cmath>
+
+// method forward declarations
+static uint64_t group_cost(uint64_t hash, uint64_t count);
+
+// the temperature, in units of cost, that the search starts at and returns to once it has cooled too far
+static const double START_TEMPERATURE = 1.0;
+static const double MIN_TEMPERATURE = 0.02;
+
+// how much the temperature is multiplied by after every change tried
+static const double COOLING = 0.9995;
+
+// most pairs of Interactions and T sets whose separations anneal() will keep; over 1 GB of counters beyond it
+static const uint64_t MAX_SEPARATIONS = uint64_t{1} << 28;
+
+// what separations between an Interaction and a T set containing it start at, so that they never fall short
+static const uint32_t NEVER_SHORT = uint32_t{1} << 30;
+
+/* SUB METHOD: anneal - tries to find arrays with fewer rows than the finished one, until time runs out
+ * - each round drops a random row from the best array found so far, then changes cells (see anneal_set())
+ *   until the cost is 0 or time runs out; half of the changes put a missing Interaction into a random row,
+ *   while the rest set a random cell to a random value
+ * - an anytime method: the best array found so far is always kept, and is the array once time runs out
+ * - rows given in the input file are never dropped or changed
+ * - the rows' bookkeeping is not updated for the rows found, so no rows should be added afterwards
+ * 
+ * parameters:
+ * - seconds: how long to search for
+ * 
+ * returns:
+ * - void, but after the method finishes, the array will hold the best rows found
+*/
+void Array::anneal(uint64_t seconds)
+{
+    if (p == all && interactions.size()*sets.size() > MAX_SEPARATIONS) {
+        if (o != silent) printf("NOTE: too many separations to keep track of while annealing; skipped\n\n");
+        return;
+    }
+    std::chrono::steady_clock::time_point end = std::chrono::steady_clock::now() + std::chrono::seconds(seconds);
+    std::clock_t start = std::clock();
+    AnnealState state;
+    state.num_rows = rows.size();
+    state.cells.resize(rows.size()*num_factors);
+    for (uint64_t row = 0; row < rows.size(); row++)
+        std::copy(rows[row], rows[row] + num_factors, state.cells.begin() + static_cast<int64_t>(row*num_factors));
+    std::vector<int> best = state.cells;
+    uint64_t best_rows = state.num_rows, moves = 0;
+    bool timed_out = false;
+    while (!timed_out && best_rows > 1 && best_rows > fixed_rows) {
+        state.cells = best;
+        state.num_rows = best_rows - 1;
+        uint64_t dropped = fixed_rows + rng.below(best_rows - fixed_rows);  // the given rows must stay
+        state.cells.erase(state.cells.begin() + static_cast<int64_t>(dropped*num_factors),
+            state.cells.begin() + static_cast<int64_t>((dropped + 1)*num_factors));
+        anneal_build(&state);
+        double temperature = START_TEMPERATURE;
+        while (state.cost() > 0 && state.num_rows > fixed_rows) {
+            if (++moves % 1024 == 0 && std::chrono::steady_clock::now() >= end) {
+                timed_out = true;
+                break;
+            }
+            uint64_t row = fixed_rows + rng.below(state.num_rows - fixed_rows), col;
+            int value;
+            if (state.missing.size() > 0 && rng.below(2) == 0) {  // put a missing Interaction into the row
+                Interaction *i = interactions[state.missing.random(0, &rng)];
+                Single *s = i->singles[rng.below(i->singles.size())];
+                col = s->factor;
+                value = static_cast<int>(s->value);
+            } else {
+                col = rng.below(num_factors);
+                value = static_cast<int>(rng.below(factors[col]->level));
+            }
+            int old = state.cells[row*num_factors + col];
+            if (value == old) continue;
+            uint64_t before = state.cost();
+            anneal_set(&state, row, col, value);
+            uint64_t after = state.cost();
+            if (after > before && std::exp(-static_cast<double>(after - before)/temperature) <= rng.unit())
+                anneal_set(&state, row, col, old);  // rejected, so undo it
+            temperature *= COOLING;
+            if (temperature < MIN_TEMPERATURE) temperature = START_TEMPERATURE;
+        }
+        if (state.cost() > 0 && state.num_rows == fixed_rows) break;   // nothing left that can change
+        if (state.cost() > 0) continue;
+        best = state.cells;
+        best_rows = state.num_rows;
+        if (o == normal) printf("Annealed the array down to %lu rows.\n", best_rows);
+    }
+
+    uint64_t num_removed = rows.size() - best_rows;
+    if (num_removed > 0) {
+        for (int *row : rows) delete[] row;
+        rows.clear();
+        for (uint64_t row = 0; row < best_rows; row++) {
+            int *new_row = new int[num_factors];
+            std::copy(best.begin() + static_cast<int64_t>(row*num_factors),
+                best.begin() + static_cast<int64_t>((row + 1)*num_factors), new_row);
+            rows.push_back(new_row);
+        }
+        num_tests = best_rows;
+    }
+    if (o != silent) printf("Annealing removed %lu rows in %.3f seconds, leaving %lu rows.\n\n", num_removed,
+        static_cast<double>(std::clock() - start)/CLOCKS_PER_SEC, num_tests);
+}
+
+/* HELPER METHOD: anneal_build - works out the bookkeeping and cost of the rows in an AnnealState from scratch
+ * 
+ * parameters:
+ * - state: the AnnealState, with its cells and num_rows set
+ * 
+ * returns:
+ * - void, but after the method finishes, the rest of the AnnealState will match its cells
+*/
+void Array::anneal_build(AnnealState *state)
+{
+    uint64_t num_sets = sets.size();
+    state->occurrences.assign(interactions.size(), 0);
+    state->row_keys.resize(state->num_rows);
+    for (uint64_t &key : state->row_keys) key = rng();
+    state->set_hashes.assign(num_sets, 0);
+    state->hash_counts.clear();
+    state->in_row.assign(num_sets, 0);
+    state->changed.assign(num_sets, 0);
+    state->move = 0;
+    if (p == all) {
+        state->separations.assign(interactions.size()*num_sets, 0);
+        for (Interaction *i : interactions)
+            for (T *t_set : i->sets) state->separations[i->rank*num_sets + t_set->rank] = NEVER_SHORT;
+    }
+
+    std::vector<uint64_t> ranks(num_tuples);
+    for (uint64_t row = 0; row < state->num_rows; row++) {
+        int *cells = &state->cells[row*num_factors];
+        uint64_t move = ++state->move;
+        for (uint64_t tuple = 0; tuple < num_tuples; tuple++) {
+            ranks[tuple] = interaction_rank(cells, tuple);
+            state->occurrences[ranks[tuple]]++;
+            for (T *t_set : interactions[ranks[tuple]]->sets) {
+                if (state->in_row[t_set->rank] == move) continue;
+                state->in_row[t_set->rank] = move;
+                state->set_hashes[t_set->rank] ^= state->row_keys[row];
+            }
+        }
+        if (p == all)
+            for (uint64_t rank : ranks)
+                for (uint64_t idx = 0; idx < num_sets; idx++)
+                    if (state->in_row[idx] != move) state->separations[rank*num_sets + idx]++;
+    }
+
+    state->missing = Worklist(interactions.size());
+    state->coverage_cost = 0;
+    for (uint64_t rank = 0; rank < interactions.size(); rank++) {
+        if (state->occurrences[rank] > 0) state->missing.remove(rank);
+        else state->coverage_cost++;
+    }
+    state->location_cost = 0;
+    for (uint64_t hash : state->set_hashes) state->hash_counts[hash]++;
+    for (const std::pair<const uint64_t, uint64_t> &group : state->hash_counts)
+        state->location_cost += group_cost(group.first, group.second);
+    state->detection_cost = 0;
+    for (uint32_t apart : state->separations) if (apart < delta) state->detection_cost += delta - apart;
+}
+
+/* HELPER METHOD: anneal_set - changes one cell of an AnnealState, keeping its bookkeeping and cost up to date
+ * - the Interactions of the row through the cell's column are the only ones to leave or join the row, and
+ *   the T sets containing them are the only ones that can; the separation between an Interaction and a T
+ *   set only changes if one of them left or joined the row
+ * 
+ * parameters:
+ * - state: the AnnealState
+ * - row: the row of the cell
+ * - col: the column of the cell
+ * - value: the cell's new value
+ * 
+ * returns:
+ * - void, but after the method finishes, the cell will have the value and the rest of the state will match
+*/
+void Array::anneal_set(AnnealState *state, uint64_t row, uint64_t col, int value)
+{
+    int *cells = &state->cells[row*num_factors];
+    int old = cells[col];
+    uint64_t move = ++state->move;
+    std::vector<uint64_t> leaving, joining;
+    for (uint64_t idx = column_starts[col]; idx < column_starts[col+1]; idx++)
+        leaving.push_back(interaction_rank(cells, column_tuples[idx]));
+    cells[col] = value;
+    for (uint64_t idx = column_starts[col]; idx < column_starts[col+1]; idx++)
+        joining.push_back(interaction_rank(cells, column_tuples[idx]));
+
+    for (uint64_t rank : leaving)
+        if (--state->occurrences[rank] == 0) {
+            state->missing.insert(rank);
+            state->coverage_cost++;
+        }
+    for (uint64_t rank : joining)
+        if (state->occurrences[rank]++ == 0) {
+            state->missing.remove(rank);
+            state->coverage_cost--;
+        }
+    if (p == c_only) return;
+
+    // T sets that left the row are among those of the Interactions leaving it, and those that joined it are
+    // among those of the Interactions joining it
+    std::vector<T*> changed_sets;
+    for (uint64_t rank : leaving)
+        for (T *t_set : interactions[rank]->sets) {
+            if (state->changed[t_set->rank] == move || occurs(t_set, cells)) continue;
+            state->changed[t_set->rank] = move;
+            changed_sets.push_back(t_set);
+        }
+    cells[col] = old;
+    for (uint64_t rank : joining)
+        for (T *t_set : interactions[rank]->sets) {
+            if (state->changed[t_set->rank] == move || occurs(t_set, cells)) continue;
+            state->changed[t_set->rank] = move;
+            changed_sets.push_back(t_set);
+        }
+    cells[col] = value;
+    for (T *t_set : changed_sets) anneal_rehash(state, t_set, row);
+    if (p != all) return;
+
+    // mark the T sets in the row now; those in it before are the same, except for the ones that changed
+    std::vector<uint64_t> staying;
+    for (uint64_t tuple = 0; tuple < num_tuples; tuple++) {
+        uint64_t rank = interaction_rank(cells, tuple);
+        for (T *t_set : interactions[rank]->sets) state->in_row[t_set->rank] = move;
+        bool through_col = false;
+        for (uint64_t j = 0; j < t; j++) through_col = through_col || tuple_columns[tuple*t + j] == col;
+        if (!through_col) staying.push_back(rank);
+    }
+    for (uint64_t rank : leaving)
+        for (T *t_set : sets)
+            if ((state->in_row[t_set->rank] == move) == (state->changed[t_set->rank] == move))
+                anneal_separate(state, rank, t_set, false); // it was not in the row, so this was separating
+    for (uint64_t rank : joining)
+        for (T *t_set : sets)
+            if (state->in_row[t_set->rank] != move) anneal_separate(state, rank, t_set, true);
+    for (uint64_t rank : staying)
+        for (T *t_set : changed_sets)   // joined the row if it is in it now, and left it otherwise
+            anneal_separate(state, rank, t_set, state->in_row[t_set->rank] != move);
+}
+
+/* HELPER METHOD: anneal_rehash - notes that a T set joined or left a row, in an AnnealState's location cost
+ * 
+ * parameters:
+ * - state: the AnnealState
+ * - t_set: the T set
+ * - row: the row it joined or left
+ * 
+ * returns:
+ * - void, but after the method finishes, the T set's hash and the location cost will be up to date
+*/
+void Array::anneal_rehash(AnnealState *state, T *t_set, uint64_t row)
+{
+    uint64_t &hash = state->set_hashes[t_set->rank];
+    std::unordered_map<uint64_t, uint64_t>::iterator group = state->hash_counts.find(hash);
+    state->location_cost -= group_cost(hash, group->second) - group_cost(hash, group->second - 1);
+    if (--group->second == 0) state->hash_counts.erase(group);
+    hash ^= state->row_keys[row];
+    uint64_t &count = state->hash_counts[hash];
+    state->location_cost += group_cost(hash, count + 1) - group_cost(hash, count);
+    count++;
+}
+
+/* HELPER METHOD: anneal_separate - changes the separation between an Interaction and a T set by one row
+ * 
+ * parameters:
+ * - state: the AnnealState
+ * - rank: the rank of the Interaction
+ * - t_set: the T set
+ * - more: whether the separation grows, rather than shrinks
+ * 
+ * returns:
+ * - void, but after the method finishes, the separation and the detection cost will be up to date
+*/
+void Array::anneal_separate(AnnealState *state, uint64_t rank, T *t_set, bool more)
+{
+    uint32_t &apart = state->separations[rank*sets.size() + t_set->rank];
+    if (more) {
+        if (apart < delta) state->detection_cost--;
+        apart++;
+    } else {
+        apart--;
+        if (apart < delta) state->detection_cost++;
+    }
+}
+
+/* UTILITY METHOD: occurs - checks whether a T set occurs in a row
+ * 
+ * returns:
+ * - true if all of the Singles of any of its Interactions are in the row, false otherwise
+*/
+bool Array::occurs(T *t_set, const int *row)
+{
+    for (Interaction *i : t_set->interactions) {
+        bool all_in = true;
+        for (Single *s : i->singles) all_in = all_in && row[s->factor] == static_cast<int>(s->value);
+        if (all_in) return true;
+    }
+    return false;
+}
+
+// ==============================   LOCAL HELPER METHODS BELOW THIS POINT   ============================== //
+
+// location cost of the count T sets sharing a hash: all of them if they occur in no rows or are not alone
+static uint64_t group_cost(uint64_t hash, uint64_t count)
+{
+    return hash == 0 || count > 1 ? count : 0;
+}
@@ -1,5 +1,5 @@
 /* Array-Generator by Isaac Jung
-Last updated 10/12/2022
+Last updated 10/16/2026
 
 |===========================================================================================================|
 |   This file contains the meat of the project's logic. The constructor for the Array class takes a pointer |
@@ -18,6 +18,8 @@ Last updated 10/12/2022
 */
 
 #include "array.h"
+#include "ipog.h"
+#include "orthogonal.h"
 #include <iostream>
 #include <algorithm>
 #include <sys/types.h>
@@ -27,11 +29,12 @@ Last updated 10/12/2022
 // method forward declarations
 static void print_failure(Interaction *interaction);
 static void print_failure(T *t_set_1, T *t_set_2);
-static void print_failure(Interaction *interaction, T *t_set, uint64_t delta, std::set<int> *dif);
+static void print_failure(Interaction *interaction, T *t_set, uint64_t delta, Bitset *dif);
 static void print_singles(Factor **factors, uint64_t num_factors);
 static void print_interactions(std::vector<Interaction*> interactions);
 static void print_sets(std::vector<T*> sets);
 static void print_debug(Factor **factors, uint64_t num_factors);
+static const char *heuristic_name(prop_mode heuristic);
 
 /* CONSTRUCTOR - initializes the object
  * - overloaded: this is the default with no parameters, and should not be used
@@ -39,6 +42,9 @@ static void print_debug(Factor **factors, uint64_t num_factors);
 Interaction::Interaction()
 {
     id = -1;
+    rank = 0;
+    weight = 0;
+    deficits = 0;
     is_covered = false;
     is_detectable = false;
 }
@@ -69,6 +75,9 @@ std::string Interaction::to_string()
 */
 T::T()
 {
+    id = -1;
+    rank = 0;
+    weight = 0;
     is_locatable = false;
 }
 
@@ -82,6 +91,7 @@ T::T(std::vector<Interaction*> *temp) : T::T()
     // next, give all involved Interactions a reference to this set and this set a reference to its Singles
     for (Interaction *interaction : *temp) {
         interaction->sets.insert(this);
+        weight += interaction->weight;
         for (Single *single : interaction->singles) singles.push_back(single);
     }
 }
@@ -109,28 +119,54 @@ Array::Array()
     coverage_problems = 0; location_problems = 0; detection_problems = 0;
     score = 0;
     d = 0; t = 0; delta = 0;
-    num_tests = 0; num_factors = 0;
+    num_tests = 0; num_factors = 0; num_tuples = 0;
+    journaled_rows = 0;
+    seed = 0; stream = 0;
+    fixed_rows = 0;
     factors = nullptr;
     v = v_off; o = normal; p = all;
     heuristic_in_use = none;
+    heuristic_challenging = none;
+    row_start_score = 0;
+    row_start_work = 0;
+    beam_width = 1; beam_depth = 1;
+    engine = greedy;
     is_covering = false; is_locating = false; is_detecting = false;
     dont_cares = nullptr;
     permutation = nullptr;
+    pool = nullptr;
+    max_level = 1;
+    incumbent = 0;
+    search_work = 0;
+    work = 0;
 }
 
 /* CONSTRUCTOR - initializes the object
  * - overloaded: this version can set its fields based on a pointer to a Parser object
+ * - every random choice made while generating is drawn from the given stream of the Parser's seed
 */
-Array::Array(Parser *in) : Array::Array()
+Array::Array(Parser *in, uint64_t stream_in) : Array::Array()
 {
-    srand(time(nullptr));   // seed rand() using current time
+    seed = in->seed; stream = stream_in;
+    rng.seed(seed);
+    for (uint64_t s = 0; s < stream; s++) rng.jump();
     d = in->d; t = in->t; delta = in->delta;
-    num_tests = in->num_rows;
+    num_tests = 0;  // the Parser's rows are only added by add_given_rows(), once everything is built
     num_factors = in->num_cols;
     dont_cares = new prop_mode[num_factors]{none};
     permutation = new int[num_factors];
     for (uint64_t col = 0; col < num_factors; col++) permutation[col] = col;
     debug = in->debug; v = in->v; o = in->o; p = in->p;
+    uint64_t num_workers = in->threads;
+    if (num_workers == 0) num_workers = std::thread::hardware_concurrency();    // 0 if it cannot tell
+    if (num_workers == 0) num_workers = 1;
+    pool = new Pool(num_workers);
+    workspaces.resize(num_workers);
+    engine = in->engine;
+    beam_width = in->beam;
+    beam_depth = beam_width > 1 ? in->depth : 1;
+    search_work = in->search_work*1000000;
+    scheduler.row_price = static_cast<double>(in->row_price)*1e6;
     
     if (o != silent) printf("Building internal data structures....\n\n");
     try {
@@ -140,24 +176,41 @@ Array::Array(Parser *in) : Array::Array()
             factors[i] = new Factor(i, in->levels.at(i), new Single*[in->levels.at(i)]);
             for (uint64_t j = 0; j < factors[i]->level; j++) {
                 factors[i]->singles[j] = new Single(i, j);
+                factors[i]->singles[j]->rank = singles.size();
                 singles.push_back(factors[i]->singles[j]);
-                single_map.insert({factors[i]->singles[j]->to_string(), factors[i]->singles[j]});
+                mark_stale(factors[i]->singles[j]); // the queues are filled in once all issues are counted
             }
         }
+        single_scores.assign(singles.size(), 0);
         if (debug == d_on) print_singles(factors, num_factors);
 
         // build all Interactions
-        std::vector<Single*> temp_singles;
-        build_t_way_interactions(0, t, &temp_singles);
+        std::vector<uint64_t> temp_columns;
+        build_t_way_interactions(0, t, &temp_columns);
+        column_starts.assign(num_factors + 1, 0);   // index the tuples by column as well
+        for (uint64_t col : tuple_columns) column_starts[col + 1]++;
+        for (uint64_t col = 0; col < num_factors; col++) column_starts[col + 1] += column_starts[col];
+        column_tuples.resize(tuple_columns.size());
+        column_radices.resize(tuple_columns.size());
+        std::vector<uint64_t> filled(column_starts.begin(), column_starts.end() - 1);
+        for (uint64_t idx = 0; idx < tuple_columns.size(); idx++) {
+            column_radices[filled[tuple_columns[idx]]] = tuple_radices[idx];
+            column_tuples[filled[tuple_columns[idx]]++] = idx/t;
+        }
         if (debug == d_on) print_interactions(interactions);
         total_problems += interactions.size();  // to account for all the coverage problems
         coverage_problems += interactions.size();
-        score += total_problems;    // the array is considered completed when this reaches 0
+        uncovered = Worklist(interactions.size());
+        score = total_problems;     // the array is considered completed when this reaches 0
         if (p == c_only) return;    // no need to spend effort building Ts if they won't be used
 
         // build all Ts
         std::vector<Interaction*> temp_interactions;
         build_size_d_sets(0, d, &temp_interactions);
+        location = Partition(sets.size()); // nothing has occurred yet, so all T sets share the same rows
+        location_weights.reserve(sets.size() + 1);
+        location_weights.push_back(0);
+        for (T *t_set : sets) location_weights[0] += t_set->weight;
         if (debug == d_on) print_sets(sets);
         for (T *t_set : sets) {
             for (Single *s : t_set->singles) {
@@ -168,25 +221,28 @@ Array::Array(Parser *in) : Array::Array()
         }
         total_problems += sets.size();  // to account for all the location problems
         location_problems += sets.size();
+        unlocated = Worklist(sets.size());  // none have occurred yet, so none have any conflicts
         score = total_problems; // need to update this
         if (p != all) return;   // can skip the following stuff if not doing detection
 
-        // build all Interactions' maps of detection issues to their deltas (row difference magnitudes)
+        // every Interaction starts with 0 separation from every T set it is NOT part of
         for (Interaction *i : interactions) {   // for all Interactions in the array
-            for (T *t_set : sets) { // for every T set this Interaction is NOT part of
-                if (i->sets.find(t_set) == i->sets.end()) {
-                    i->deltas.insert({t_set, 0});
-                    for (Single *s: i->singles) {
-                        factors[s->factor]->d_issues += delta;
-                        s->d_issues += delta;
-                        total_problems += delta;
-                        score += delta;
-                    }
-                }
+            i->deficits = sets.size() - i->sets.size();
+            for (Single *s: i->singles) {
+                factors[s->factor]->d_issues += delta*i->deficits;
+                s->d_issues += delta*i->deficits;
+                total_problems += delta*i->deficits;
+                score += delta*i->deficits;
             }
         }
+        separation = Separation(interactions.size(), sets.size(), delta);
+        for (Interaction *i : interactions) // a T set containing the Interaction can never be separated from it
+            for (T *t_set : i->sets) separation.saturate(i->rank, t_set->rank);
+        if (debug == d_on) printf("==%d== Separation store uses %lu bytes\n\n", getpid(), separation.bytes());
         total_problems += interactions.size();  // to account for all the detection issues
         detection_problems += interactions.size();
+        undetectable = Worklist(interactions.size());   // filed under how far they are from δ separation
+        for (Interaction *i : interactions) undetectable.insert(i->rank, i->deficits > 0 ? delta : 0);
         score += interactions.size();   // need to update this one last time
 
     } catch (const std::bad_alloc& e) {
@@ -195,83 +251,62 @@ Array::Array(Parser *in) : Array::Array()
     }
 }
 
-/* CONSTRUCTOR - initializes the object
- * - overloaded: this version can set its private fields based on existing data
- *  --> intended to be used ONLY BY Array::clone()
-*/
-Array::Array(uint64_t total_problems_o, uint64_t coverage_problems_o, uint64_t location_problems_o,
-    uint64_t detection_problems_o, std::vector<int*> *rows_o, uint64_t num_tests_o, uint64_t num_factors_o,
-    Factor **factors_o, prop_mode p_o, uint64_t d_o, uint64_t t_o, uint64_t delta_o): Array::Array()
-{
-    total_problems = total_problems_o;
-    coverage_problems = coverage_problems_o;
-    location_problems = location_problems_o;
-    detection_problems = detection_problems_o;
-    d = d_o; t = t_o; delta = delta_o;
-    num_tests = num_tests_o; num_factors = num_factors_o;
-    o = silent; p = p_o;
-    factors = new Factor*[num_factors];
-    for (uint64_t i = 0; i < num_factors; i++) {
-        factors[i] = new Factor(i, factors_o[i]->level, new Single*[factors_o[i]->level]);
-        for (uint64_t j = 0; j < factors[i]->level; j++) {
-            factors[i]->singles[j] = new Single(i, j);
-            singles.push_back(factors[i]->singles[j]);
-            single_map.insert({factors[i]->singles[j]->to_string(), factors[i]->singles[j]});
-        }
-    }
-    std::vector<Single*> temp_singles;
-    build_t_way_interactions(0, t, &temp_singles);
-    if (p == c_only) return;
-    std::vector<Interaction*> temp_interactions;
-    build_size_d_sets(0, d, &temp_interactions);
-    //for (Interaction *i : interactions)
-    //    for (T *t_set : sets)
-    //        if (i->sets.find(t_set) == i->sets.end())
-    //            i->deltas.insert({t_set, 0});
-    for (int* row_o : *rows_o) {
-        int* row = new int[num_factors];
-        for (uint64_t col = 0; col < num_factors; col++) row[col] = row_o[col];
-        rows.push_back(row);
-    }
-}
-
 /* HELPER METHOD: build_t_way_interactions - initializes the interactions vector recursively
  * - the factors array must be initialized before calling this method
  * - top down recursive; auxiliary caller should use 0, t, and an empty vector as initial parameters
  *   --> do not use the interactions vector itself as the parameter
  * - this method should not be called more than once
+ * - the recursion picks the column tuples; once a tuple is complete, all of its level combinations are laid
+ *   out contiguously in mixed-radix order, so any Interaction can later be found by rank without a lookup
  * 
  * parameters:
  * - start: left side of factors array at which to begin the outer for loop
  * - t: desired strength of interactions
- * - singles_so_far: auxiliary vector of pointers used to track the current combination of Singles
+ * - columns_so_far: auxiliary vector used to track the current combination of columns
  * 
  * returns:
- * - void, but after the method finishes, the array's interactions vector will be initialized
+ * - void, but after the method finishes, the array's interactions vector and tuple index will be initialized
 */
-void Array::build_t_way_interactions(uint64_t start, uint64_t t_cur, std::vector<Single*> *singles_so_far)
+void Array::build_t_way_interactions(uint64_t start, uint64_t t_cur, std::vector<uint64_t> *columns_so_far)
 {
-    // base case: interaction is completed and ready to store
+    // base case: column tuple is completed, so store every Interaction it can hold
     if (t_cur == 0) {
-        Interaction *new_interaction = new Interaction(singles_so_far);
-        interactions.push_back(new_interaction);
-        interaction_map.insert({new_interaction->to_string(), new_interaction});    // for later accessing
-        for (Single *single : new_interaction->singles) {
-            factors[single->factor]->c_issues++;
-            single->c_issues++;
-            total_problems++;
-            score++;
+        uint64_t count = 1;
+        tuple_offsets.push_back(interactions.size());
+        tuple_radices.resize(tuple_radices.size() + t);
+        for (uint64_t j = t; j > 0; j--) {  // last column varies fastest
+            tuple_columns.push_back(columns_so_far->at(t - j));
+            tuple_radices[num_tuples*t + j - 1] = count;
+            count *= factors[columns_so_far->at(j - 1)]->level;
         }
+        for (uint64_t idx = 0; idx < count; idx++) {
+            std::vector<Single*> temp_singles;
+            for (uint64_t j = 0; j < t; j++) {
+                uint64_t col = columns_so_far->at(j);
+                temp_singles.push_back(factors[col]->singles[idx / tuple_radices[num_tuples*t + j] %
+                    factors[col]->level]);  // note these are Single *
+            }
+            Interaction *new_interaction = new Interaction(&temp_singles);
+            new_interaction->rank = interactions.size();
+            for (Single *single : new_interaction->singles)
+                new_interaction->weight += factors[single->factor]->level;
+            interactions.push_back(new_interaction);
+            for (Single *single : new_interaction->singles) {
+                factors[single->factor]->c_issues++;
+                single->c_issues++;
+                total_problems++;
+                score++;
+            }
+        }
+        num_tuples++;
         return;
     }
 
     // recursive case: need to introduce another loop for higher strength
     for (uint64_t col = start; col < num_factors - t_cur + 1; col++) {
-        for (uint64_t level = 0; level < factors[col]->level; level++) {
-            singles_so_far->push_back(factors[col]->singles[level]);    // note these are Single *
-            build_t_way_interactions(col+1, t_cur-1, singles_so_far);
-            singles_so_far->pop_back();
-        }
+        columns_so_far->push_back(col);
+        build_t_way_interactions(col+1, t_cur-1, columns_so_far);
+        columns_so_far->pop_back();
     }
 }
 
@@ -294,8 +329,8 @@ void Array::build_size_d_sets(uint64_t start, uint64_t d_cur, std::vector<Intera
     // base case: set is completed and ready to store
     if (d_cur == 0) {
         T *new_set = new T(interactions_so_far);
+        new_set->rank = sets.size();
         sets.push_back(new_set);
-        t_set_map.insert({new_set->to_string(), new_set});  // for later accessing
         return;
     }
 
@@ -308,31 +343,39 @@ void Array::build_size_d_sets(uint64_t start, uint64_t d_cur, std::vector<Intera
 }
 
 /* HELPER METHOD: build_row_interactions - recovers the Interaction objects based on the given row
- * - top down recursive; auxiliary caller should use 0, t, and an empty string as initial parameters
- * - this method should be called for every unique row considered; note that this gets expensive
+ * - this method should be called for every unique row considered; it does no allocation once the list has
+ *   grown to hold C(num_factors, t) Interactions, so callers should reuse the same list where possible
  * 
  * parameters:
  * - row: integer array representing a row up for consideration for appending to the array
- * - row_interactions: initially empty set to hold the Interactions as they are recovered
- * - start: left side of row at which to begin the for loop
- * - t_cur: distance from right side of row at which to end the for loop
- * - key: auxiliary vector of pointers used to track the current combination of Singles
+ * - row_interactions: list to hold the Interactions as they are recovered; cleared first
  * 
  * returns:
- * - void, but after the method finishes, the row_interactions set will hold all the interactions in the row
+ * - void, but after the method finishes, the row_interactions list will hold all the interactions in the row,
+ *   ordered by column tuple
 */
-void Array::build_row_interactions(int *row, std::set<Interaction*> *row_interactions,
-    uint64_t start, uint64_t t_cur, std::string key)
+void Array::build_row_interactions(int *row, std::vector<Interaction*> *row_interactions)
 {
-    if (t_cur == 0) {
-        row_interactions->insert(interaction_map.at(key));
-        return;
-    }
+    row_interactions->clear();
+    for (uint64_t tuple = 0; tuple < num_tuples; tuple++)
+        row_interactions->push_back(interactions[interaction_rank(row, tuple)]);
+}
 
-    for (uint64_t col = start; col < num_factors - t_cur + 1; col++) {
-        std::string cur = key + "f" + std::to_string(col) + "," + std::to_string(row[col]);
-        build_row_interactions(row, row_interactions, col+1, t_cur-1, cur);
-    }
+/* HELPER METHOD: interaction_rank - finds which Interaction of a column tuple occurs in the given row
+ * 
+ * parameters:
+ * - row: integer array representing a row up for consideration for appending to the array
+ * - tuple: index of the column tuple of interest
+ * 
+ * returns:
+ * - the rank of the Interaction, i.e., its index in the interactions vector
+*/
+uint64_t Array::interaction_rank(int *row, uint64_t tuple)
+{
+    uint64_t rank = tuple_offsets[tuple];
+    const uint64_t *columns = &tuple_columns[tuple*t], *radices = &tuple_radices[tuple*t];
+    for (uint64_t j = 0; j < t; j++) rank += static_cast<uint64_t>(row[columns[j]])*radices[j];
+    return rank;
 }
 
 /* UTILITY METHOD: print_stats - outputs current state of the Array to console
@@ -376,22 +419,305 @@ void Array::print_stats(bool initial)
     if (v == v_on) {
         if (heuristic_in_use == c_only) printf("\t- Using heuristic_c_only.\n");
         else if (heuristic_in_use == l_only) printf("\t- Using heuristic_l_only.\n");
+        else if (heuristic_in_use == d_only) printf("\t- Using heuristic_d_only.\n");
         else if (heuristic_in_use == all) printf("\t- Using heuristic_all.\n");
     }
 }
 
+/* SUB METHOD: add_ipog_rows - builds a covering array a column at a time, then adds all its rows
+ * - see ipog.h for how the columns are added; only meant for covering arrays, and much faster than adding
+ *   rows one at a time when there are many factors, since no row ever has to be scored
+ * - don't cares left in the rows are filled in with random values within their factors' levels
+ * 
+ * returns:
+ * - void, but after the method finishes, the array will be covering
+*/
+void Array::add_ipog_rows()
+{
+    std::vector<uint64_t> levels(num_factors);
+    for (uint64_t col = 0; col < num_factors; col++) levels[col] = factors[col]->level;
+    Ipog engine_rows(levels, t);
+    engine_rows.build();
+    for (const std::vector<int> &cells : engine_rows.rows) {
+        int *new_row = new int[num_factors];
+        for (uint64_t col = 0; col < num_factors; col++)
+            new_row[col] = cells[col] != Ipog::DONT_CARE ? cells[col] :
+                static_cast<int>(rng.below(factors[col]->level));
+        update_array(new_row);
+    }
+}
+
+/* SUB METHOD: add_given_rows - adds the rows given in the input file, before any others
+ * - the rows are added the same way as any other, so the heuristics only have to solve what they leave
+ * - the rows are never removed or changed afterwards by prune_rows() or anneal()
+ * 
+ * parameters:
+ * - in: Parser object that has already had its process_input() method called
+ * 
+ * returns:
+ * - void, but after the method finishes, the array will start with the given rows
+*/
+void Array::add_given_rows(Parser *in)
+{
+    for (uint64_t *given : in->array) {
+        int *new_row = new int[num_factors];
+        for (uint64_t col = 0; col < num_factors; col++) new_row[col] = static_cast<int>(given[col]);
+        update_array(new_row);
+    }
+    fixed_rows = num_tests;
+}
+
+/* SUB METHOD: add_orthogonal_rows - seeds an empty array with the rows of an orthogonal array of strength 2
+ * - see orthogonal.h for how the rows are built; only done when t is 2, and when the largest number of
+ *   levels q is a prime power that at least two factors have, since any array covering those two factors
+ *   needs q*q rows, so no rows are wasted
+ * - the orthogonal array has q+1 columns, which go to the factors with the most levels; a factor with fewer
+ *   than q levels takes the value mod its levels, which keeps every pair of its values with the others
+ * - when there are more than q+1 factors, this is only done if they all have q levels, in which case each
+ *   factor beyond the first q+1 copies a column already used, in reverse order, so that it only misses pairs
+ *   with the factor it copies; mixed levels are left to the heuristics then, since the rows end up doing
+ *   worse than theirs
+ * 
+ * returns:
+ * - true if the rows were added, false if the array was left alone
+*/
+bool Array::add_orthogonal_rows()
+{
+    if (t != 2 || num_tests != 0 || num_factors < 2) return false;
+    uint64_t q = 0, at_most = 0;    // number of levels of the factors with the most levels, and how many have it
+    for (uint64_t col = 0; col < num_factors; col++) {
+        if (factors[col]->level > q) {
+            q = factors[col]->level;
+            at_most = 0;
+        }
+        if (factors[col]->level == q) at_most++;
+    }
+    if (at_most < 2 || !Orthogonal::is_prime_power(q)) return false;
+    if (num_factors > q + 1 && at_most < num_factors) return false;
+
+    std::vector<uint64_t> order(num_factors);   // factors by levels, most first
+    for (uint64_t col = 0; col < num_factors; col++) order[col] = col;
+    std::stable_sort(order.begin(), order.end(),
+        [&](uint64_t a, uint64_t b) { return factors[a]->level > factors[b]->level; });
+    Orthogonal seed_rows(q);
+    seed_rows.build();
+    for (const std::vector<int> &cells : seed_rows.rows) {
+        int *new_row = new int[num_factors];
+        for (uint64_t idx = 0; idx < num_factors; idx++) {
+            uint64_t col = order[idx];
+            uint64_t source = idx <= q ? idx : q - (idx - q - 1) % (q + 1);
+            new_row[col] = cells[source] % static_cast<int>(factors[col]->level);
+        }
+        update_array(new_row);
+    }
+    if (o != silent) printf("Seeded the array with the %lu rows of an orthogonal array over GF(%lu).\n\n",
+        q*q, q);
+    return true;
+}
+
+/* SUB METHOD: prune_rows - removes every row that the finished array can do without, one at a time
+ * - each row is tried in the given order, and removed if the array would keep every property asked for
+ *   without it; see is_redundant() for how that is checked without checking the whole array again
+ * - rows given in the input file are never tried
+ * - should only be called once the array is finished; since no property is lost, the scores, issues,
+ *   location classes, separations (which stop counting at δ), worklists, and don't cares all stay as they
+ *   are, and only the rows themselves change: the bits of removed rows are cleared as they go, and the rest
+ *   are renumbered at the end (see renumber_rows()), so the array can be added to or checked afterwards
+ * 
+ * parameters:
+ * - order: which rows to try first; should not be prune_off
+ * 
+ * returns:
+ * - void, but after the method finishes, the array will hold only the rows that were not removed
+*/
+void Array::prune_rows(prune_order order)
+{
+    std::clock_t start = std::clock();
+    std::vector<uint64_t> order_tried(rows.size());
+    for (uint64_t idx = 0; idx < rows.size(); idx++)
+        order_tried[idx] = order == prune_newest ? rows.size() - 1 - idx : idx;
+    if (order == prune_random) std::shuffle(order_tried.begin(), order_tried.end(), rng);
+    order_tried.erase(std::remove_if(order_tried.begin(), order_tried.end(),
+        [&](uint64_t idx) { return idx < fixed_rows; }), order_tried.end());    // the given rows must stay
+
+    // hash every T set's rows, so that location conflicts can be found by looking up a hash
+    row_keys.resize(rows.size() + 1);   // row idx is bit idx + 1 (see update_array())
+    for (uint64_t &key : row_keys) key = rng();
+    set_hashes.assign(sets.size(), 0);
+    hashed_sets.clear();
+    for (T *t_set : sets) {
+        for (uint64_t bit : t_set->rows) set_hashes[t_set->rank] ^= row_keys[bit];
+        hashed_sets[set_hashes[t_set->rank]].push_back(t_set);
+    }
+
+    std::vector<bool> removed(rows.size(), false);
+    uint64_t num_removed = 0;
+    std::vector<Interaction*> row_interactions;
+    std::vector<T*> row_sets;
+    for (uint64_t idx : order_tried) {
+        uint64_t bit = idx + 1;
+        if (!is_redundant(bit, &row_interactions, &row_sets)) continue;
+        for (uint64_t col = 0; col < num_factors; col++) factors[col]->singles[rows[idx][col]]->rows.reset(bit);
+        for (Interaction *i : row_interactions) i->rows.reset(bit);
+        for (T *t_set : row_sets) {
+            unhash_set(t_set);
+            t_set->rows.reset(bit);
+            set_hashes[t_set->rank] ^= row_keys[bit];
+            hashed_sets[set_hashes[t_set->rank]].push_back(t_set);
+        }
+        removed[idx] = true;
+        num_removed++;
+    }
+
+    std::vector<int*> kept;
+    std::vector<uint64_t> new_bits(rows.size() + 1, 0);
+    for (uint64_t idx = 0; idx < rows.size(); idx++) {
+        if (removed[idx]) delete[] rows[idx];
+        else {
+            kept.push_back(rows[idx]);
+            new_bits[idx + 1] = kept.size();
+        }
+    }
+    rows.swap(kept);
+    num_tests = rows.size();
+    renumber_rows(new_bits);
+    hashed_sets.clear();
+    if (o != silent) printf("Pruned %lu redundant rows in %.3f seconds, leaving %lu rows.\n\n", num_removed,
+        static_cast<double>(std::clock() - start)/CLOCKS_PER_SEC, num_tests);
+}
+
+/* HELPER METHOD: is_redundant - checks whether the array would keep its properties without a row
+ * - only what occurs in the row can be affected, so only that is checked:
+ *   coverage: every Interaction in the row must occur in some other row
+ *   location: every T set in the row must occur in some other row, and must not end up occurring in exactly
+ *     the same rows as any other T set; only T sets not in the row can newly share its rows, and finding them
+ *     takes one hash lookup, then an exact check against any T set with that hash
+ *   detection: every Interaction in the row loses a row of separation from each T set not in the row (and
+ *     not containing it), so each of those separations must be more than δ; this is counted from the rows
+ *     themselves, since the stored separations stop counting at δ; a T set sharing none of the Interaction's
+ *     other rows is separated from it by all of them, so only the T sets in those rows need counting, unless
+ *     going through those would take longer than counting every T set
+ * 
+ * parameters:
+ * - bit: the bit of the row in the row sets (one more than its index in rows)
+ * - row_interactions: set to the Interactions occurring in the row
+ * - row_sets: set to the T sets occurring in the row, each appearing once
+ * 
+ * returns:
+ * - true if the row can be removed, false otherwise
+*/
+bool Array::is_redundant(uint64_t bit, std::vector<Interaction*> *row_interactions, std::vector<T*> *row_sets)
+{
+    row_interactions->clear();
+    row_sets->clear();
+    build_row_interactions(rows[bit - 1], row_interactions);
+    for (Interaction *i : *row_interactions) if (i->rows.count() == 1) return false;
+    if (p == c_only) return true;
+
+    row_set_ranks.clear();
+    for (Interaction *i : *row_interactions)
+        for (T *t_set : i->sets) {
+            if (row_set_ranks.test(t_set->rank)) continue;
+            row_set_ranks.set(t_set->rank);
+            row_sets->push_back(t_set);
+        }
+    for (T *t_set : *row_sets) {
+        if (t_set->rows.count() == 1) return false;
+        std::unordered_map<uint64_t, std::vector<T*>>::iterator found =
+            hashed_sets.find(set_hashes[t_set->rank] ^ row_keys[bit]);
+        if (found == hashed_sets.end()) continue;
+        for (T *other : found->second)
+            if (!other->rows.test(bit) && other->rows.count() == t_set->rows.count() - 1 &&
+                other->rows.count_andnot(t_set->rows) == 0) return false;
+    }
+    if (p != all) return true;
+
+    std::vector<Interaction*> other_interactions;
+    std::vector<T*> checked;
+    bool redundant = true;
+    for (Interaction *i : *row_interactions) {
+        if (i->rows.count() <= delta) return false; // not even a T set in none of its other rows is far enough
+        if (2*(i->rows.count() - 1)*row_sets->size() >= sets.size()) { // reaching a T set by row costs about 2x
+            for (T *t_set : sets)   // the T sets containing the Interaction are in the row, so they are skipped
+                if (!t_set->rows.test(bit) && i->rows.count_andnot(t_set->rows, delta + 1) <= delta) return false;
+            continue;
+        }
+        for (uint64_t other : i->rows) {
+            if (other == bit) continue;
+            build_row_interactions(rows[other - 1], &other_interactions);
+            for (Interaction *j : other_interactions)
+                for (T *t_set : j->sets) {
+                    if (t_set->rows.test(bit) || checked_set_ranks.test(t_set->rank)) continue;
+                    checked_set_ranks.set(t_set->rank);
+                    checked.push_back(t_set);
+                    if (i->rows.count_andnot(t_set->rows, delta + 1) <= delta) redundant = false;
+                }
+            if (!redundant) break;
+        }
+        for (T *t_set : checked) checked_set_ranks.reset(t_set->rank);
+        checked.clear();
+        if (!redundant) return false;
+    }
+    return true;
+}
+
+/* HELPER METHOD: unhash_set - takes a T set out of the list for its current hash, for prune_rows()
+*/
+void Array::unhash_set(T *t_set)
+{
+    std::unordered_map<uint64_t, std::vector<T*>>::iterator found = hashed_sets.find(set_hashes[t_set->rank]);
+    std::vector<T*> &listed = found->second;
+    listed.erase(std::find(listed.begin(), listed.end(), t_set));
+    if (listed.empty()) hashed_sets.erase(found);
+}
+
+/* HELPER METHOD: renumber_rows - moves the bit of every row in the row sets of the Singles, Interactions, and
+ * T sets, for prune_rows()
+ * 
+ * parameters:
+ * - new_bits: per old bit, the bit the row has now; the bits of removed rows must already be cleared
+ * 
+ * returns:
+ * - void, but after the method finishes, every row set will use the new bits
+*/
+void Array::renumber_rows(const std::vector<uint64_t> &new_bits)
+{
+    Bitset renumbered;
+    auto renumber = [&](Bitset *row_set) {
+        renumbered.clear();
+        for (uint64_t bit : *row_set) renumbered.set(new_bits[bit]);
+        *row_set = renumbered;
+    };
+    for (Single *s : singles) renumber(&s->rows);
+    for (Interaction *i : interactions) renumber(&i->rows);
+    for (T *t_set : sets) renumber(&t_set->rows);
+}
+
 /* SUB METHOD: update_array - updates data structures to reflect changes caused by adding a new row
  * 
  * parameters:
  * - row: integer array representing a row that should be added to the array
  * - keep: boolean representing whether or not the changes are intended to be kept
- *  --> true by default; when false, score changes are kept but the row itself is not added
+ *  --> true by default; when false, every change is journaled so that rollback() can undo it exactly
+ *  --> rows with keep == false may be stacked, but must all be rolled back before a row is kept
  * 
  * returns:
  * - void, but after the method finishes, the array will have a new row appended to its end
 */
 void Array::update_array(int *row, bool keep)
 {
+    journal.recording = !keep;
+    if (!keep) {    // array-wide fields change too often to journal individually, so save them up front
+        journal.save(&score);
+        journal.save(&coverage_problems);
+        journal.save(&location_problems);
+        journal.save(&detection_problems);
+        journal.save(&is_covering);
+        journal.save(&is_locating);
+        journal.save(&is_detecting);
+        if (debug == d_on && journaled_rows == 0) trial_order = location.elements;
+        journaled_rows++;
+    }
     rows.push_back(row);
     if (o == normal && keep) {
         printf("> Pushed row:\t");
@@ -400,56 +726,82 @@ void Array::update_array(int *row, bool keep)
     }
     num_tests++;
 
-    std::set<Interaction*> row_interactions;    // all Interactions that occur in this row
-    build_row_interactions(row, &row_interactions, 0, t, "");
-    std::set<T*> row_sets;  // all T sets that occur in this row
+    std::vector<Interaction*> row_interactions; // all Interactions that occur in this row
+    build_row_interactions(row, &row_interactions);
+    std::vector<T*> row_sets;   // all T sets that occur in this row
     for (Interaction *i : row_interactions) {
-        for (Single *s: i->singles) s->rows.insert(num_tests); // add the row to Singles in this Interaction
-        i->rows.insert(num_tests); // add the row to this Interaction itself
+        for (Single *s: i->singles) s->rows.set(num_tests); // add the row to Singles in this Interaction
+        i->rows.set(num_tests); // add the row to this Interaction itself
         for (T *t_set : i->sets) {
-            t_set->rows.insert(num_tests);  // add the row to all T sets this Interaction is part of
-            row_sets.insert(t_set);         // also add the T set to row_sets
+            if (t_set->rows.test(num_tests)) continue;  // already reached through another Interaction
+            t_set->rows.set(num_tests);     // add the row to all T sets this Interaction is part of
+            row_sets.push_back(t_set);      // also add the T set to row_sets
         }
     }
     
     update_scores(&row_interactions, &row_sets);
+    journal.recording = false;
 
-    // note: if keep == false, then caller must store previous score and coverage, location, and detection
-    // issue counts for array and individual Singles; after this method completes, caller should restore them
-    if (keep) { // if keep == true, update don't cares and heuristic that should be used based on changes
-        update_dont_cares();
-        update_heuristic();
-        return;
+    if (keep) update_dont_cares();  // the heuristic to use is up to add_row(), which measures its own rows
+}
+
+/* SUB METHOD: rollback - undoes every row added by update_array() with keep == false
+ * - takes time proportional to the number of changes those rows made, not to the size of the array
+ * - the rows themselves are not freed; they still belong to whoever passed them in
+ * 
+ * returns:
+ * - void, but after the method finishes, the array will be exactly as it was before those rows were added
+*/
+void Array::rollback()
+{
+    std::vector<Interaction*> row_interactions;
+    bool checking = debug == d_on && journaled_rows > 0;
+    for (; journaled_rows > 0; journaled_rows--) {
+        build_row_interactions(rows.back(), &row_interactions);
+        for (Interaction *i : row_interactions) {
+            for (Single *s: i->singles) s->rows.reset(num_tests);
+            i->rows.reset(num_tests);
+            for (T *t_set : i->sets) t_set->rows.reset(num_tests);
+        }
+        num_tests--;
+        rows.pop_back();
     }
-    for (Interaction *i : row_interactions) {
-        for (Single *s: i->singles) s->rows.erase(num_tests);
-        i->rows.erase(num_tests);
+    journal.restore(&location);
+    location_weights.resize(location.num_classes());
+    if (checking) { // what is visited in the classes' order must not depend on what rows were tried
+        bool same = location.elements == trial_order;
+        for (uint64_t idx = 0; same && idx < location.elements.size(); idx++)
+            same = location.position[location.elements[idx]] == idx;
+        if (!same) printf("==%d== ERROR: rollback left the location classes' members in another order\n", getpid());
     }
-    for (T *t_set : row_sets) t_set->rows.erase(num_tests);
-    num_tests--;
-    rows.pop_back();
 }
 
 /* HELPER METHOD: update_scores - updates overall scores as well as for individual Singles, Interactions, Ts
  * 
  * parameters:
- * - row_interactions: set containing all Interactions present in the new row
+ * - row_interactions: list containing all Interactions present in the new row
  * - row_sets: set containing all T sets present in the new row
  * 
  * returns:
  * - void, but after the method finishes, scores will be updated
  *  --> additionally, all Singles, Interactions, and Ts will have their data structures updated accordingly
 */
-void Array::update_scores(std::set<Interaction*> *row_interactions, std::set<T*> *row_sets)
+void Array::update_scores(std::vector<Interaction*> *row_interactions, std::vector<T*> *row_sets)
 {
+    if (p == all) for (T *t_set : *row_sets) row_set_ranks.set(t_set->rank);
     // coverage and detection are associated with interactions
     for (Interaction *i : *row_interactions) {
         // coverage
         if (!i->is_covered) {   // if true, this Interaction just became covered
+            journal.save(&i->is_covered);
             i->is_covered = true;
+            if (!journal.recording) uncovered.remove(i->rank);
             for (Single *s: i->singles) {
+                journal.save(&factors[s->factor]->c_issues);
+                journal.save(&s->c_issues);
                 factors[s->factor]->c_issues--;
                 s->c_issues--;
+                mark_stale(s);
                 score--;
             }
             score--;    // array score improves for the solved coverage problem
@@ -459,100 +811,169 @@ void Array::update_scores(std::set<Interaction*> *row_interactions, std::set<T*>
         // detection
         if (p == all) { // the following is only done if we care about detection
             if (i->is_detectable) continue; // can skip all this checking if already detectable
-            i->is_detectable = true;    // about to set it back to false if anything is unsatisfied still
-            // updating detection issues for this Interaction:
-            std::set<T*> other_sets = *row_sets;    // will hold all row T sets this Interaction is NOT in
-            for (T *t_set : i->sets) other_sets.erase(t_set);
-            for (T *t_set : other_sets) {   // for every T set in this row that this Interaction is not in,
-                if (i->deltas.at(t_set) <= static_cast<int64_t>(delta))
-                    for (Single *s: i->singles) {
-                        factors[s->factor]->d_issues++;
-                        s->d_issues++;  // to balance out a -- later
-                        score++;
-                    }
-                i->deltas.at(t_set)--;  // to balance out all deltas getting ++ after this
+            // every T set not in this row (which excludes those this Interaction is in) gains separation
+            uint64_t reached, lowest;
+            uint64_t solved = separation.advance(i->rank, row_set_ranks, &reached, &lowest, &journal);
+            for (Single *s: i->singles) {   // detection issues solved for all Singles involved
+                journal.save(&factors[s->factor]->d_issues);
+                journal.save(&s->d_issues);
+                factors[s->factor]->d_issues -= solved;
+                s->d_issues -= solved;
+                if (solved > 0) mark_stale(s);
+                score -= solved;
             }
-            for (auto& kv : i->deltas) {    // for all T sets,
-                kv.second++;    // increase their separation; offset by the -- earlier for T sets in this row
-                if (kv.second < static_cast<int64_t>(delta)) i->is_detectable = false;    // separation still not high enough
-                if (kv.second <= static_cast<int64_t>(delta)) // detection issue heading towards solved for all Singles involved
-                    for (Single *s: i->singles) {
-                        factors[s->factor]->d_issues--;
-                        s->d_issues--;
-                        score--;
-                    }
-            }
-            if (i->is_detectable) { // if true, this Interaction just became detectable
+            journal.save(&i->deficits);
+            i->deficits -= reached;
+            if (i->deficits == 0) { // if true, this Interaction just became detectable
+                journal.save(&i->is_detectable);
+                i->is_detectable = true;
+                if (!journal.recording) undetectable.remove(i->rank);
                 score--;    // array score improves for the solved detection problem
                 if (--detection_problems == 0) is_detecting = true;
-            }
+            } else if (!journal.recording) undetectable.insert(i->rank, delta - lowest);
         }
     }
 
     // location is associated with sets of interactions
-    if (p != c_only && !is_locating) {  // the following is only done if we care about location
-        for (T *t1 : *row_sets) {   // for every T set in this row,
-            if (t1->is_locatable) continue;
-            if (t1->rows.size() == 1) {   // if true, this is the first time the set has been added, so
-                for (Single *s : t1->singles) {
-                    factors[s->factor]->l_issues -= sets.size();
-                    s->l_issues -= sets.size();
-                    score -= sets.size();
-                }
-                for (T *t2 : *row_sets) {   // for every other T set in this row,
-                    if (t1 == t2 || t2->rows.size() > 1) continue;  // (skip when either of these is true)
-                    t1->location_conflicts.insert(t2);  // can assume there is a location conflict
-                    for (Single *s: t1->singles) {  // scores actually worsen here
-                        factors[s->factor]->l_issues++;
-                        s->l_issues++;
-                        score++;
-                    }
-                }
-            } else {    // need to check if location issues were solved
-                std::set<T*> temp = t1->location_conflicts; // make a shallow copy (for mutating), and
-                uint64_t solved = 0;
-                std::set<T*> others;
-                for (T *t2 : t1->location_conflicts)    // for every T set in the current T's conflicts,
-                    if (row_sets->find(t2) == row_sets->end()) {    // if that set is not in this row,
-                        temp.erase(t2); // it is no longer an issue for the current T
-                        solved++;
-                        if (t2->location_conflicts.erase(t1) == 1) {    // vice versa:
-                            for (Single *s : t2->singles) { // conflicting T also had a location issue solved
-                                factors[s->factor]->l_issues--;
-                                s->l_issues--;
-                                score--;
-                            }
-                            if (t2->location_conflicts.size() == 0) {   // if true,
-                                t2->is_locatable = true;    // conflicting T just became locatable
-                                score--;    // array score improves for the solved location problem
-                                location_problems--;
-                                if (location_problems == 0) {
-                                    printf("ERROR: Unexpected behavior here, rerun in debug mode\n");
-                                    exit(-1);
-                                }
-                            }
-                        } else {
-                            printf("ERROR: Unexpected behavior here, rerun in debug mode\n");
-                            exit(-1);
-                        }
-                    }
-                for (Single *s: t1->singles) {  // update scores
-                    factors[s->factor]->l_issues -= solved;
-                    s->l_issues -= solved;
-                    score -= solved;
-                }
-                t1->location_conflicts = temp;  // mutating completed, can update original now
+    if (p != c_only && !is_locating) update_location(row_sets);    // only done if we care about location
+    if (p == all) for (T *t_set : *row_sets) row_set_ranks.reset(t_set->rank);
+}
+
+/* HELPER METHOD: update_location - updates location issues for the T sets in a new row
+ * - called by update_scores(); the row must already be in the row sets of all the T sets given
+ * - every class of T sets with identical rows is split into the members in the new row and those not in it;
+ *   each member of one side stops conflicting with each member of the other side
+ * 
+ * parameters:
+ * - row_sets: list containing all T sets present in the new row, each appearing once
+ * 
+ * returns:
+ * - void, but after the method finishes, location scores and the location partition will be updated
+*/
+void Array::update_location(std::vector<T*> *row_sets)
+{
+    for (T *t_set : *row_sets)  // locatable T sets are already alone in their class, so leave them be
+        if (!t_set->is_locatable) journal.save_mark(t_set->rank, location.mark(t_set->rank));
+    std::vector<Split> splits;
+    location.refine(&splits);
+    location_weights.resize(location.num_classes(), 0);
+    if (journal.recording) journal.splits.insert(journal.splits.end(), splits.begin(), splits.end());
+
+    for (Split &split : splits) {
+        uint64_t num_unmarked = split.size - split.num_marked;
+        uint64_t *in_row = &location.elements[location.starts[split.marked]];
+        if (split.unmarked != Split::NO_CLASS) {    // the T sets in this row now make up a class of their own
+            journal.save(&location_weights[split.unmarked]);    // the new class is dropped on rollback anyway
+            for (uint64_t idx = 0; idx < split.num_marked; idx++)
+                location_weights[split.marked] += sets[in_row[idx]]->weight;
+            location_weights[split.unmarked] -= location_weights[split.marked];
+        }
+        if (sets[in_row[0]]->rows.count() == 1) {   // if true, this is the first time these sets have been added
+            for (uint64_t idx = 0; idx < split.num_marked; idx++) {
+                T *t_set = sets[in_row[idx]];
+                shift_l_issues(t_set, -static_cast<int64_t>(sets.size()));
+                // can assume there is a location conflict with the other sets in this row added for the first time
+                shift_l_issues(t_set, static_cast<int64_t>(split.num_marked - 1)); // scores actually worsen here
+                if (split.num_marked == 1) set_locatable(t_set);
+                file_conflicts(t_set);
             }
-            if (t1->location_conflicts.size() == 0) {   // if true,
-                t1->is_locatable = true;    // this T just became locatable
-                score--;    // array score improves for the solved location problem
-                location_problems--;
-                if (location_problems == 0) is_locating = true;
+        } else if (num_unmarked > 0) {  // sets in this row are no longer in conflict with those that are not
+            for (uint64_t idx = 0; idx < split.num_marked; idx++) {
+                T *t_set = sets[in_row[idx]];
+                shift_l_issues(t_set, -static_cast<int64_t>(num_unmarked));
+                if (split.num_marked == 1) set_locatable(t_set);
+                file_conflicts(t_set);
+            }
+            for (uint64_t idx = location.starts[split.unmarked]; idx < location.ends[split.unmarked]; idx++) {
+                T *t_set = sets[location.elements[idx]];
+                shift_l_issues(t_set, -static_cast<int64_t>(split.num_marked));
+                if (num_unmarked == 1) set_locatable(t_set);
+                file_conflicts(t_set);
             }
         }
     }
 }
 
+/* HELPER METHOD: shift_l_issues - adds to the location issues of all the Singles in a T set
+ * 
+ * parameters:
+ * - t_set: the T set whose Singles are affected (a Single occurring in it more than once is shifted for each)
+ * - change: how much to add; negative when location issues are solved
+ * 
+ * returns:
+ * - void, but after the method finishes, the Singles, their Factors, and the array score will be updated
+*/
+void Array::shift_l_issues(T *t_set, int64_t change)
+{
+    for (Single *s : t_set->singles) {
+        journal.save(&factors[s->factor]->l_issues);
+        journal.save(&s->l_issues);
+        factors[s->factor]->l_issues += change;
+        s->l_issues += change;
+        mark_stale(s);
+        score += static_cast<uint64_t>(change); // wraps around correctly for negative changes
+    }
+}
+
+/* HELPER METHOD: set_locatable - records that a T set just became locatable
+*/
+void Array::set_locatable(T *t_set)
+{
+    journal.save(&t_set->is_locatable);
+    t_set->is_locatable = true;
+    score--;    // array score improves for the solved location problem
+    if (--location_problems == 0) is_locating = true;
+}
+
+/* HELPER METHOD: file_conflicts - refiles a T set in the unlocated worklist under its location conflicts
+ * - called by update_location() for every T set whose class it changes; does nothing for rows not kept
+*/
+void Array::file_conflicts(T *t_set)
+{
+    if (journal.recording) return;
+    if (t_set->is_locatable) unlocated.remove(t_set->rank);
+    else unlocated.insert(t_set->rank, location_conflicts(t_set));
+}
+
+/* HELPER METHOD: mark_stale - notes that a Single's issues changed, so that file_singles() will refile it
+*/
+void Array::mark_stale(Single *s)
+{
+    if (s->stale) return;
+    s->stale = true;
+    stale_singles.push_back(s);
+}
+
+/* HELPER METHOD: file_singles - refiles every stale Single in its Factor's queue under its current issues
+ * - costs time proportional to the number of Singles whose issues changed, not to the number of Singles
+ * - does nothing while rows added with keep == false are in place, since their issues are about to be undone
+ * 
+ * returns:
+ * - void, but after the method finishes, every Factor's queue will match the issues of its Singles
+*/
+void Array::file_singles()
+{
+    if (journaled_rows > 0) return;
+    for (Single *s : stale_singles) {
+        int64_t issues = static_cast<int64_t>(s->c_issues) + s->l_issues + 3*static_cast<int64_t>(s->d_issues);
+        factors[s->factor]->queue.insert(s->value, issues > 0 ? static_cast<uint64_t>(issues) : 0);
+        s->stale = false;
+    }
+    stale_singles.clear();
+}
+
+/* UTILITY METHOD: location_conflicts - counts the other T sets occurring in exactly the same rows as a T set
+ * - T sets that have never occurred are not counted as conflicting with each other
+ * 
+ * returns:
+ * - the number of location conflicts the T set currently has
+*/
+uint64_t Array::location_conflicts(T *t_set)
+{
+    if (t_set->rows.empty()) return 0;
+    return location.class_size(t_set->rank) - 1;
+}
+
 /* HELPER METHOD: update_dont_cares - updates column-total information to track don't care states
  *  --> should only call when adding (and keeping) a row, after update_scores() is called
  * 
@@ -581,81 +1002,57 @@ void Array::update_dont_cares()
 }
 
 /* HELPER METHOD: update_heuristic - looks at overall states and decides whether to switch heuristics
- *  --> should only call when adding (and keeping) a row, after update_scores() is called
+ *  --> should only be called by add_row(), after it keeps a row, or before its first row if others were seeded
+ * - the row just added is measured by the scheduler, unless add_row() already measured it in a duel; then,
+ *   the scheduler picks the heuristic to use and any other heuristic due to duel it (see scheduler.h)
  * 
  * returns:
- * - void, but after the method finishes, heuristic_in_use may have changed
+ * - void, but after the method finishes, heuristic_in_use and heuristic_challenging may have changed
 */
 void Array::update_heuristic()
 {
-    // TODO: work on making this as more heuristics are created and tested
-    float ratio = static_cast<float>(score)/total_problems;
-    bool satisfied = false; // used repeatedly to decide whether it is time to switch heuristics
-
-    // first up, should we use the most in-depth scoring function:
-    if (p == c_only) {
-        if (total_problems < 500) satisfied = true; // arbitrary choice
-        else if (ratio < 0.90) satisfied = true;    // arbitrary choice
-    } else if (p == c_and_l) {
-        if (total_problems < 450) satisfied = true; // arbitrary choice
-        else if (ratio < 0.85) satisfied = true;    // arbitrary choice
-    } else {    // p == all
-        if (total_problems < 400) satisfied = true; // arbitrary choice
-        else if (ratio < 0.80) satisfied = true;    // arbitrary choice
-    }
-    if (satisfied) {
-        heuristic_in_use = all;
-        return;
-    }
+    // the very first row is random, so there is nothing to learn from it
+    if (heuristic_in_use != none && heuristic_challenging == none)
+        scheduler.record(heuristic_in_use, row_start_score, score, static_cast<double>(total_work() - row_start_work));
+    if (v == v_on && heuristic_challenging != none)
+        printf("\t- Dueled heuristic_%s with heuristic_%s; over their last %lu duels or fewer, it was %.2f times "
+            "as efficient.\n", heuristic_name(heuristic_challenging), heuristic_name(heuristic_in_use),
+            Scheduler::DUELS, scheduler.advantage(heuristic_challenging));
 
-    // TODO: come up with more heuristics
-    
-    // if not far enough yet, go with the simplistic coverage-only heuristic
-    heuristic_in_use = c_only;
-    //*/
-}
-
-Array *Array::clone()
-{
-    // instantiate with private fields, copy public fields manually
-    Array *clone = new Array(total_problems, coverage_problems, location_problems, detection_problems,
-        &rows, num_tests, num_factors, factors, p, d, t, delta);
-    clone->score = score;
-    clone->is_covering = is_covering;
-    clone->is_locating = is_locating;
-    clone->is_detecting = is_detecting;
-
-    // brand new Singles, Interactions, and Ts had to be allocated, so deep copying of data needed
-    for (Single *this_s : singles) {
-        Single *clone_s = clone->single_map.at(this_s->to_string());
-        clone_s->rows = this_s->rows;
-        clone_s->c_issues = this_s->c_issues;
-        clone_s->l_issues = this_s->l_issues;
-        clone_s->d_issues = this_s->d_issues;
-    }
-    for (Interaction *this_i : interactions) {
-        // DEBUG point
-        Interaction *clone_i = clone->interaction_map.at(this_i->to_string());
-        clone_i->rows = this_i->rows;
-        clone_i->is_covered = this_i->is_covered;
-        clone_i->is_detectable = this_i->is_detectable;
-        for (auto& kv : this_i->deltas) {
-            T *clone_t = clone->t_set_map.at(kv.first->to_string());
-            //clone_i->deltas.at(clone_t) = kv.second;
-            clone_i->deltas.insert({clone_t, kv.second});
-        }
-    }
-    for (T *this_t : sets) {
-        T *clone_t = clone->t_set_map.at(this_t->to_string());
-        clone_t->rows = this_t->rows;
-        clone_t->is_locatable = this_t->is_locatable;
-        for (T *other_t : this_t->location_conflicts) {
-            T *clone_other_t = clone->t_set_map.at(other_t->to_string());
-            clone_t->location_conflicts.insert(clone_other_t);
-        }
+    // the heuristics worth considering given what is left to solve; heuristic_l_only can stall for good when
+    // locating sets of more than one interaction, and heuristic_d_only has so far needed more rows than
+    // heuristic_all for the same detection tail, in about the same time, so both are left out of those cases
+    std::vector<prop_mode> eligible = {c_only};
+    if (p != c_only && d == 1 && is_covering && !is_locating) eligible.push_back(l_only);
+    eligible.push_back(all);
+
+    // start out with the simplistic coverage-only heuristic, which comes first
+    prop_mode next = scheduler.choose(eligible, score, &heuristic_challenging);
+
+    if (v == v_on && next != heuristic_in_use && heuristic_in_use != none) {
+        printf("\t- Switching to heuristic_%s; measured over each one's last %lu rows or fewer:\n",
+            heuristic_name(next), Scheduler::WINDOW);
+        for (prop_mode h : eligible)
+            if (scheduler.samples(h) > 0)
+                printf("\t\t* heuristic_%s: solved %.3f%% of what was left per row, %.3f%% per billion Interactions "
+                    "and T sets looked at\n", heuristic_name(h), 100*scheduler.gain_per_row(h),
+                    100e9*scheduler.gain_per_work(h));
     }
+    heuristic_in_use = next;
+}
 
-    return clone;
+/* UTILITY METHOD: total_work - gets how much work has gone into building rows so far
+ * - counted in Interactions and T sets looked at, which is what the heuristics spend nearly all of their time
+ *   on; unlike CPU time, this comes out the same on every machine and for any number of worker threads
+ * 
+ * returns:
+ * - the Interactions and T sets looked at by the main thread and by every worker
+*/
+uint64_t Array::total_work()
+{
+    uint64_t total = work;
+    for (const Workspace &ws : workspaces) total += ws.work;
+    return total;
 }
 
 /* UTILITY METHOD: to_string - gets a string representation of the array
@@ -685,6 +1082,7 @@ Array::~Array()
     for (T *t_set : sets) delete t_set;
     delete[] dont_cares;
     delete[] permutation;
+    delete pool;
 }
 
 // ==============================   LOCAL HELPER METHODS BELOW THIS POINT   ============================== //
@@ -715,19 +1113,19 @@ static void print_failure(T *t_set_1, T *t_set_2)
         output = output.substr(0, output.size() - 2) + "}; ";
     }
     output = output.substr(0, output.size() - 2) + " }\n\tRows: { ";
-    for (int row : t_set_1->rows) output += std::to_string(row) + ", ";
+    for (uint64_t row : t_set_1->rows) output += std::to_string(row) + ", ";
     output = output.substr(0, output.size() - 2) + " }\n";
     std::cout << output << std::endl;
 }
 
-static void print_failure(Interaction *interaction, T *t_set, uint64_t delta, std::set<int> *dif)
+static void print_failure(Interaction *interaction, T *t_set, uint64_t delta, Bitset *dif)
 {
     printf("\t-- ROW DIFFERENCE LESS THAN %lu --\n", delta);
     std::string output("\tInt: {");
     for (Single *s : interaction->singles)
         output += "(f" + std::to_string(s->factor) + ", " + std::to_string(s->value) + "), ";
     output = output.substr(0, output.size() - 2) + "}, { ";
-    for (int row : interaction->rows) output += std::to_string(row) + ", ";
+    for (uint64_t row : interaction->rows) output += std::to_string(row) + ", ";
     output = output.substr(0, output.size() - 2) + " }\n\tSet: { {";
     for (Interaction *i : t_set->interactions) {
         for (Single *s : i->singles)
@@ -735,14 +1133,30 @@ static void print_failure(Interaction *interaction, T *t_set, uint64_t delta, st
         output = output.substr(0, output.size() - 2) + "}; {";
     }
     output = output.substr(0, output.size() - 3) + " }, { ";
-    for (int row : t_set->rows) output += std::to_string(row) + ", ";
+    for (uint64_t row : t_set->rows) output += std::to_string(row) + ", ";
     output = output.substr(0, output.size() - 2) + " }\n\tDif: { ";
-    for (int row : *dif) output += std::to_string(row) + ", ";
-    if (dif->size() > 0) output = output.substr(0, output.size() - 2) + " }\n";
+    for (uint64_t row : *dif) output += std::to_string(row) + ", ";
+    if (!dif->empty()) output = output.substr(0, output.size() - 2) + " }\n";
     else output += "}\n";
     std::cout << output << std::endl;
 }
 
+// the part of a heuristic's method name after "heuristic_"
+static const char *heuristic_name(prop_mode heuristic)
+{
+    switch (heuristic) {
+        case c_only: return "c_only";
+        case l_only: return "l_only";
+        case d_only: return "d_only";
+        case all: return "all";
+        case none:
+        case c_and_l:
+        case c_and_d:
+        case l_and_d:
+        default: return "none";
+    }
+}
+
 static void print_singles(Factor **factors, uint64_t num_factors)
 {
     int pid = getpid();
@@ -751,7 +1165,7 @@ static void print_singles(Factor **factors, uint64_t num_factors)
         printf("Factor %lu:\n", factors[col]->id);
         for (uint64_t level = 0; level < factors[col]->level; level++) {
             printf("\t(f%lu, %lu): {", factors[col]->singles[level]->factor, factors[col]->singles[level]->value);
-            for (int row : factors[col]->singles[level]->rows) printf(" %d", row);
+            for (uint64_t row : factors[col]->singles[level]->rows) printf(" %lu", row);
             printf(" }\n");
         }
         printf("\n");
@@ -768,7 +1182,7 @@ static void print_interactions(std::vector<Interaction*> interactions)
         printf("Interaction %d:\n\tInt: {", i);
         for (Single *s : interaction->singles) printf(" (f%lu, %lu)", s->factor, s->value);
         printf(" }\n\tRows: {");
-        for (int row : interaction->rows) printf(" %d", row);
+        for (uint64_t row : interaction->rows) printf(" %lu", row);
         printf(" }\n\n");
     }
 }
@@ -783,7 +1197,7 @@ static void print_sets(std::vector<T*> sets)
         printf("Set %d:\n\tSet: {", i);
         for (Interaction *interaction : t_set->interactions) printf(" %d", interaction->id);
         printf(" }\n\tRows: {");
-        for (int row : t_set->rows) printf(" %d", row);
+        for (uint64_t row : t_set->rows) printf(" %lu", row);
         printf(" }\n\n");
     }
 }
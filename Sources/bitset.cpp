@@ -0,0 +1,175 @@
+/* Array-Generator by Isaac Jung
+Last updated 10/16/2026
+
+|===========================================================================================================|
+|   This file contains definitions for the Bitset class declared in bitset.h that are not small enough to   |
+| be worth inlining. See that header for a description of how row sets are stored.                          |
+|===========================================================================================================|
+*/
+
+#include "bitset.h"
+#include <cstring>
+
+/* CONSTRUCTOR - initializes the object
+ * - overloaded: this is the default with no parameters; no storage is allocated until a bit is set
+*/
+Bitset::Bitset()
+{
+    words = nullptr;
+    num_words = 0;
+    num_bits = 0;
+}
+
+/* CONSTRUCTOR - initializes the object
+ * - overloaded: this version copies the bits of another Bitset
+*/
+Bitset::Bitset(const Bitset &other) : Bitset::Bitset()
+{
+    *this = other;
+}
+
+/* OPERATOR: = - replaces the bits of this Bitset with those of another
+ * - the storage is only reallocated when this Bitset is too small to hold the other's words
+*/
+Bitset &Bitset::operator=(const Bitset &other)
+{
+    if (this == &other) return *this;
+    if (num_words < other.num_words) {
+        delete[] words;
+        words = new uint64_t[other.num_words];
+        num_words = other.num_words;
+    }
+    if (other.num_words > 0) memcpy(words, other.words, other.num_words*sizeof(uint64_t));
+    if (num_words > other.num_words)
+        memset(words + other.num_words, 0, (num_words - other.num_words)*sizeof(uint64_t));
+    num_bits = other.num_bits;
+    return *this;
+}
+
+/* HELPER METHOD: grow - reallocates the storage so that it holds at least the given number of words
+ * - the capacity at least doubles each time, so that setting bits in increasing order costs amortized O(1)
+*/
+void Bitset::grow(uint64_t min_words)
+{
+    uint64_t new_words = num_words == 0 ? 1 : 2*num_words;
+    if (new_words < min_words) new_words = min_words;
+    uint64_t *new_storage = new uint64_t[new_words]{0};
+    if (num_words > 0) memcpy(new_storage, words, num_words*sizeof(uint64_t));
+    delete[] words;
+    words = new_storage;
+    num_words = new_words;
+}
+
+/* SUB METHOD: set - sets a bit, growing the storage if the bit lies beyond the current capacity
+*/
+void Bitset::set(uint64_t bit)
+{
+    if ((bit >> 6) >= num_words) grow((bit >> 6) + 1);
+    uint64_t mask = static_cast<uint64_t>(1) << (bit & 63);
+    if ((words[bit >> 6] & mask) == 0) {
+        words[bit >> 6] |= mask;
+        num_bits++;
+    }
+}
+
+/* SUB METHOD: reset - clears a bit; bits beyond the current capacity are already clear
+*/
+void Bitset::reset(uint64_t bit)
+{
+    if ((bit >> 6) >= num_words) return;
+    uint64_t mask = static_cast<uint64_t>(1) << (bit & 63);
+    if ((words[bit >> 6] & mask) != 0) {
+        words[bit >> 6] &= ~mask;
+        num_bits--;
+    }
+}
+
+/* SUB METHOD: clear - clears every bit without giving up the storage
+*/
+void Bitset::clear()
+{
+    if (num_words > 0) memset(words, 0, num_words*sizeof(uint64_t));
+    num_bits = 0;
+}
+
+/* SUB METHOD: count_andnot - counts the bits set in this Bitset but not in another
+ * - this is the size of the set difference; for an Interaction's rows and a T set's rows, it is the
+ *   separation used to define detection
+ *
+ * parameters:
+ * - other: the Bitset whose bits are subtracted
+ * - cap: counting stops early once this many bits have been found (useful when only a threshold matters)
+ *
+ * returns:
+ * - |this \ other|, or some value >= cap if counting stopped early
+*/
+uint64_t Bitset::count_andnot(const Bitset &other, uint64_t cap) const
+{
+    uint64_t count = 0, shared = num_words < other.num_words ? num_words : other.num_words;
+    for (uint64_t w = 0; w < shared && count < cap; w++)
+        count += static_cast<uint64_t>(__builtin_popcountll(words[w] & ~other.words[w]));
+    for (uint64_t w = shared; w < num_words && count < cap; w++)
+        count += static_cast<uint64_t>(__builtin_popcountll(words[w]));
+    return count;
+}
+
+/* SUB METHOD: same_as - checks whether two Bitsets have exactly the same bits set, regardless of capacity
+ * - for two T sets, this is the check for a location conflict
+*/
+bool Bitset::same_as(const Bitset &other) const
+{
+    if (num_bits != other.num_bits) return false;
+    uint64_t shared = num_words < other.num_words ? num_words : other.num_words;
+    for (uint64_t w = 0; w < shared; w++) if (words[w] != other.words[w]) return false;
+    return true;    // equal counts and equal shared words means any leftover words must be 0 on both sides
+}
+
+/* SUB METHOD: unite - sets every bit that is set in another Bitset (set union)
+*/
+void Bitset::unite(const Bitset &other)
+{
+    if (num_words < other.num_words) grow(other.num_words);
+    num_bits = 0;
+    for (uint64_t w = 0; w < num_words; w++) {
+        if (w < other.num_words) words[w] |= other.words[w];
+        num_bits += static_cast<uint64_t>(__builtin_popcountll(words[w]));
+    }
+}
+
+/* DECONSTRUCTOR - frees memory
+*/
+Bitset::~Bitset()
+{
+    delete[] words;
+}
+
+/* CONSTRUCTOR - initializes the iterator at the first set bit at or after start
+*/
+Bitset::iterator::iterator(const Bitset *b, uint64_t start)
+{
+    owner = b;
+    bit = start;
+    if (bit == UINT64_MAX) return;
+    uint64_t w = bit >> 6;
+    if (w >= owner->num_words) {
+        bit = UINT64_MAX;
+        return;
+    }
+    uint64_t word = owner->words[w] & (~static_cast<uint64_t>(0) << (bit & 63));
+    while (word == 0) {
+        if (++w >= owner->num_words) {
+            bit = UINT64_MAX;
+            return;
+        }
+        word = owner->words[w];
+    }
+    bit = (w << 6) + static_cast<uint64_t>(__builtin_ctzll(word));
+}
+
+/* OPERATOR: ++ - advances the iterator to the next set bit, or to the end
+*/
+Bitset::iterator &Bitset::iterator::operator++()
+{
+    *this = iterator(owner, bit + 1);
+    return *this;
+}
@@ -0,0 +1,320 @@
+/* Array-Generator by Isaac Jung
+Last updated 10/16/2026
+
+|===========================================================================================================|
+|   This file contains definitions for methods belonging to the Writer and Reader classes declared in       |
+| checkpoint.h, followed by the Array's methods for saving and resuming from checkpoints. See that header   |
+| for a description of the format.                                                                          |
+|===========================================================================================================|
+*/
+
+#include "checkpoint.h"
+#include "array.h"
+#include <cstdio>
+#include <cstring>
+#include <ctime>
+#include <fstream>
+#include <sstream>
+
+// method forward declarations
+static uint64_t fnv1a(const std::string &bytes, uint64_t length);
+
+// eight bytes, not counting the terminator
+const char Writer::MAGIC[] = "ARRAYGEN";
+
+/* SUB METHOD: integer - writes an integer as a variable-length quantity
+ * 
+ * parameters:
+ * - value: the integer to write
+ * 
+ * returns:
+ * - void, but after the method finishes, bytes will end with the integer
+*/
+void Writer::integer(uint64_t value)
+{
+    while (value >= 0x80) {
+        bytes.push_back(static_cast<char>((value & 0x7F) | 0x80));
+        value >>= 7;
+    }
+    bytes.push_back(static_cast<char>(value));
+}
+
+/* SUB METHOD: real - writes a double as the eight bytes of its bit pattern, lowest first
+ * 
+ * parameters:
+ * - value: the double to write
+ * 
+ * returns:
+ * - void, but after the method finishes, bytes will end with the double
+*/
+void Writer::real(double value)
+{
+    uint64_t bits;
+    std::memcpy(&bits, &value, sizeof(bits));
+    for (int b = 0; b < 8; b++) bytes.push_back(static_cast<char>(bits >> (8*b) & 0xFF));
+}
+
+/* SUB METHOD: start - writes what every checkpoint starts with
+ * 
+ * returns:
+ * - void, but after the method finishes, bytes will hold the magic string and version
+*/
+void Writer::start()
+{
+    bytes.assign(MAGIC, 8);
+    integer(VERSION);
+}
+
+/* SUB METHOD: finish - appends the hash of everything written so far
+ * 
+ * returns:
+ * - void, but after the method finishes, bytes will be a complete checkpoint
+*/
+void Writer::finish()
+{
+    uint64_t hash = fnv1a(bytes, bytes.size());
+    for (int b = 0; b < 8; b++) bytes.push_back(static_cast<char>(hash >> (8*b) & 0xFF));
+}
+
+/* CONSTRUCTOR - initializes the object
+ * - overloaded: this version reads from the bytes of a whole checkpoint, which must outlive it
+*/
+Reader::Reader(const std::string &bytes_o) : bytes(bytes_o)
+{
+    position = 0;
+    end = bytes.size() >= 8 ? bytes.size() - 8 : 0;
+}
+
+/* SUB METHOD: start - reads what every checkpoint starts with
+ * 
+ * returns:
+ * - true if the magic string and version are those of checkpoints written by this program, false otherwise
+*/
+bool Reader::start()
+{
+    if (end < 8 || bytes.compare(0, 8, Writer::MAGIC, 8) != 0) return false;
+    position = 8;
+    uint64_t version;
+    return integer(&version) && version == Writer::VERSION;
+}
+
+/* SUB METHOD: integer - reads an integer written as a variable-length quantity
+ * 
+ * parameters:
+ * - value: pointer to set to the integer read
+ * 
+ * returns:
+ * - true if an integer was read, false if the checkpoint ended first or the integer was too long
+*/
+bool Reader::integer(uint64_t *value)
+{
+    *value = 0;
+    for (int shift = 0; shift < 64 && position < end; shift += 7) {
+        uint64_t byte = static_cast<unsigned char>(bytes[position++]);
+        *value |= (byte & 0x7F) << shift;
+        if ((byte & 0x80) == 0) return true;
+    }
+    return false;
+}
+
+/* SUB METHOD: real - reads a double written as the eight bytes of its bit pattern
+ * 
+ * parameters:
+ * - value: pointer to set to the double read
+ * 
+ * returns:
+ * - true if a double was read, false if the checkpoint ended first
+*/
+bool Reader::real(double *value)
+{
+    if (end - position < 8) return false;
+    uint64_t bits = 0;
+    for (int b = 0; b < 8; b++) bits |= static_cast<uint64_t>(static_cast<unsigned char>(bytes[position++])) << (8*b);
+    std::memcpy(value, &bits, sizeof(bits));
+    return true;
+}
+
+/* UTILITY METHOD: intact - checks the hash at the end of the checkpoint
+ * 
+ * returns:
+ * - true if the hash matches everything before it, false otherwise
+*/
+bool Reader::intact() const
+{
+    if (bytes.size() < 8) return false;
+    uint64_t hash = 0;
+    for (int b = 0; b < 8; b++) hash |= static_cast<uint64_t>(static_cast<unsigned char>(bytes[end + b])) << (8*b);
+    return hash == fnv1a(bytes, end);
+}
+
+/* SUB METHOD: save_checkpoint - writes what is needed to resume generating the array later
+ * - see checkpoint.h for what is written; the file is written under another name and then renamed, so that
+ *   a checkpoint already there is never left half overwritten
+ * - should only be called between rows
+ * 
+ * parameters:
+ * - path: where to write the checkpoint
+ * 
+ * returns:
+ * - true if the checkpoint was written, false otherwise
+*/
+bool Array::save_checkpoint(const std::string &path)
+{
+    Writer out;
+    out.start();
+    out.integer(d); out.integer(t); out.integer(delta); out.integer(p);
+    out.integer(num_factors);
+    for (uint64_t col = 0; col < num_factors; col++) out.integer(factors[col]->level);
+    out.integer(seed); out.integer(stream); out.integer(fixed_rows);
+    out.integer(rows.size());
+    for (int *row : rows) for (uint64_t col = 0; col < num_factors; col++) out.integer(row[col]);
+    rng.save(&out);
+    for (uint64_t col = 0; col < num_factors; col++) out.integer(permutation[col]);
+    out.integer(heuristic_in_use); out.integer(heuristic_challenging);
+    scheduler.save(&out);
+    for (uint64_t col = 0; col < num_factors; col++) factors[col]->queue.save(&out);
+    uncovered.save(&out); unlocated.save(&out); undetectable.save(&out);
+    out.integer(stale_singles.size());
+    for (Single *s : stale_singles) out.integer(s->rank);
+    out.finish();
+
+    std::string temp = path + ".tmp";
+    std::ofstream file(temp.c_str(), std::ofstream::out | std::ofstream::binary | std::ofstream::trunc);
+    file.write(out.bytes.data(), static_cast<std::streamsize>(out.bytes.size()));
+    file.close();
+    if (!file || std::rename(temp.c_str(), path.c_str()) != 0) {
+        printf("NOTE: could not write checkpoint <%s>; generation continues without it\n", path.c_str());
+        return false;
+    }
+    if (o == normal) printf("Saved a checkpoint of %lu rows to <%s>.\n", num_tests, path.c_str());
+    return true;
+}
+
+/* SUB METHOD: resume - picks up generating the array from a checkpoint
+ * - everything is read and checked before anything is changed; the rows are then added the usual way, which
+ *   gets back everything that follows from them, and the rest is restored as it was saved
+ * - this includes the order of the location classes' members, which decides the order T sets are filed
+ *   in the unlocated worklist; rows the saving run tried and rolled back left that order as they found it
+ * - the Array should not have any rows yet, and should have been constructed from the same input file and
+ *   arguments as the one that saved the checkpoint
+ * 
+ * parameters:
+ * - path: where to read the checkpoint from
+ * 
+ * returns:
+ * - true if the array now holds the rows and state saved in the checkpoint, false if it was left alone
+*/
+bool Array::resume(const std::string &path)
+{
+    std::ifstream file(path.c_str(), std::ifstream::in | std::ifstream::binary);
+    if (!file.is_open()) {
+        printf("\t-- ERROR --\n\tUnable to open checkpoint with path name <%s>.\n\n", path.c_str());
+        return false;
+    }
+    std::stringstream buffer;
+    buffer << file.rdbuf();
+    file.close();
+    std::string bytes = buffer.str();
+    Reader in(bytes);
+    if (!in.intact() || !in.start()) {
+        printf("\t-- ERROR --\n\t<%s> is not a checkpoint written by this version, or was cut short.\n\n",
+            path.c_str());
+        return false;
+    }
+
+    // the checkpoint must be of the same problem
+    std::vector<uint64_t> expected = {d, t, delta, static_cast<uint64_t>(p), num_factors};
+    for (uint64_t col = 0; col < num_factors; col++) expected.push_back(factors[col]->level);
+    uint64_t value;
+    for (uint64_t e : expected) {
+        if (!in.integer(&value) || value != e) {
+            printf("\t-- ERROR --\n\tCheckpoint <%s> was saved for other factors or properties.\n", path.c_str());
+            printf("\tResume with the same input file and arguments it was saved with.\n\n");
+            return false;
+        }
+    }
+
+    // then everything else, checked as it is read
+    uint64_t saved_seed = 0, saved_stream = 0, saved_fixed = 0, saved_rows = 0;
+    bool ok = in.integer(&saved_seed) && in.integer(&saved_stream) && in.integer(&saved_fixed) &&
+        in.integer(&saved_rows) && saved_fixed <= saved_rows;
+    std::vector<int> cells;
+    for (uint64_t idx = 0; ok && idx < saved_rows*num_factors; idx++) {
+        ok = in.integer(&value) && value < factors[idx % num_factors]->level;
+        cells.push_back(static_cast<int>(value));
+    }
+    Rng saved_rng;
+    ok = ok && saved_rng.load(&in);
+    std::vector<int> saved_permutation;
+    std::vector<bool> seen(num_factors, false);
+    for (uint64_t col = 0; ok && col < num_factors; col++) {
+        ok = in.integer(&value) && value < num_factors && !seen[value];
+        if (ok) seen[value] = true;
+        saved_permutation.push_back(static_cast<int>(value));
+    }
+    uint64_t saved_in_use = 0, saved_challenging = 0;
+    ok = ok && in.integer(&saved_in_use) && saved_in_use <= all && in.integer(&saved_challenging) &&
+        saved_challenging <= all;
+    Scheduler saved_scheduler = scheduler;  // a copy, so that it keeps the row price given
+    ok = ok && saved_scheduler.load(&in);
+    std::vector<SparseWorklist> saved_queues;   // copies, so that they know how many members they can hold
+    for (uint64_t col = 0; col < num_factors; col++) {
+        saved_queues.push_back(factors[col]->queue);
+        ok = ok && saved_queues.back().load(&in);
+    }
+    Worklist saved_uncovered = uncovered, saved_unlocated = unlocated, saved_undetectable = undetectable;
+    ok = ok && saved_uncovered.load(&in) && saved_unlocated.load(&in) && saved_undetectable.load(&in);
+    uint64_t num_stale = 0;
+    std::vector<Single*> saved_stale;
+    std::vector<bool> stale(singles.size(), false);
+    ok = ok && in.integer(&num_stale) && num_stale <= singles.size();
+    for (uint64_t idx = 0; ok && idx < num_stale; idx++) {
+        ok = in.integer(&value) && value < singles.size() && !stale[value];
+        if (ok) stale[value] = true;
+        if (ok) saved_stale.push_back(singles[value]);
+    }
+    ok = ok && in.done();
+    if (!ok) {
+        printf("\t-- ERROR --\n\tCheckpoint <%s> is damaged.\n\n", path.c_str());
+        return false;
+    }
+
+    // add the rows quietly, then put back what does not follow from them; the scheduler only measures rows
+    // from add_row(), so replaying them leaves its state as loaded
+    std::clock_t start = std::clock();
+    debug_mode saved_debug = debug; verb_mode saved_v = v; out_mode saved_o = o;
+    debug = d_off; v = v_off; o = silent;
+    for (uint64_t row = 0; row < saved_rows; row++) {
+        int *new_row = new int[num_factors];
+        std::copy(cells.begin() + static_cast<int64_t>(row*num_factors),
+            cells.begin() + static_cast<int64_t>((row + 1)*num_factors), new_row);
+        update_array(new_row);
+    }
+    debug = saved_debug; v = saved_v; o = saved_o;
+    seed = saved_seed; stream = saved_stream; fixed_rows = saved_fixed;
+    rng = saved_rng;
+    std::copy(saved_permutation.begin(), saved_permutation.end(), permutation);
+    heuristic_in_use = static_cast<prop_mode>(saved_in_use);
+    heuristic_challenging = static_cast<prop_mode>(saved_challenging);
+    scheduler = saved_scheduler;
+    for (uint64_t col = 0; col < num_factors; col++) factors[col]->queue = saved_queues[col];
+    uncovered = saved_uncovered; unlocated = saved_unlocated; undetectable = saved_undetectable;
+    for (Single *s : singles) s->stale = stale[s->rank];
+    stale_singles = saved_stale;
+    if (o != silent) printf("Resumed from checkpoint <%s> with %lu rows, replayed in %.3f seconds.\n\n",
+        path.c_str(), num_tests, static_cast<double>(std::clock() - start)/CLOCKS_PER_SEC);
+    return true;
+}
+
+// ==============================   LOCAL HELPER METHODS BELOW THIS POINT   ============================== //
+
+// 64-bit FNV-1a hash of the first length bytes
+static uint64_t fnv1a(const std::string &bytes, uint64_t length)
+{
+    uint64_t hash = 0xCBF29CE484222325;
+    for (uint64_t idx = 0; idx < length; idx++) {
+        hash ^= static_cast<unsigned char>(bytes[idx]);
+        hash *= 0x100000001B3;
+    }
+    return hash;
+}
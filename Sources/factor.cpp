@@ -20,6 +20,8 @@ Single::Single()
     c_issues = 0; l_issues = 0; d_issues = 0;   // to be incremented later
     factor = 0;
     value = 0;
+    rank = 0;
+    stale = false;
 }
 
 /* CONSTRUCTOR - initializes the object
@@ -56,6 +58,7 @@ Factor::Factor(uint64_t i, uint64_t l, Single **ptr_array) : Factor::Factor()
     id = i;
     level = l;
     singles = ptr_array;
+    queue = SparseWorklist(l);
 }
 
 /* DECONSTRUCTOR - frees memory
@@ -1,5 +1,5 @@
 /* Array-Generator by Isaac Jung
-Last updated 10/06/2022
+Last updated 10/16/2026
 
 |===========================================================================================================|
 |   This file contains the main() method which reflects the high level flow of the program. It starts by    |
@@ -33,6 +33,11 @@ Last updated 10/06/2022
 #include <sys/types.h>
 #include <unistd.h>
 #include <stdlib.h>
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <csignal>
+#include <thread>
 
 
 // ================================v=v=v== static global variables ==v=v=v================================ //
@@ -41,14 +46,19 @@ static debug_mode dm;   // debug mode
 static verb_mode vm;    // verbose mode
 static out_mode om;     // output mode
 static prop_mode pm;    // property mode
+static volatile sig_atomic_t signalled = 0;  // SIGTERM or SIGUSR1 if either was received, 0 otherwise
 
 // ================================^=^=^== static global variables ==^=^=^================================ //
 
 
 // =========================v=v=v== static methods - forward declarations ==v=v=v========================= //
 
+static bool generate(Parser *p, Array *array, std::atomic<uint64_t> *best);
+static Array *run_portfolio(Parser *p, bool *success);
 static int print_results(Parser *p, Array *array, bool success);
-static void debug_print(int d, int t, int delta);
+static void on_signal(int signal_number);
+static void debug_print(int d, int t, int delta, uint64_t threads, uint64_t beam, uint64_t depth,
+    engine_mode engine);
 
 // =========================^=^=^== static methods - forward declarations ==^=^=^========================= //
 
@@ -69,27 +79,158 @@ int main(int argc, char *argv[])
     dm = p.debug; vm = p.v; om = p.o; pm = p.p; // update flags based on those processed by the Parser
     
 	int status = p.process_input();                 // read in and process the array
-    if (dm == d_on) debug_print(p.d, p.t, p.delta); // print status when verbose mode enabled
+    if (dm == d_on) debug_print(p.d, p.t, p.delta, p.threads, p.beam, p.depth, p.engine);  // print status
     if (status == -1) return 1;        // exit immediately if there is a basic syntactic or semantic error
     
-    Array array(&p);    // create Array object that immediately builds appropriate data structures
-    if (array.score == 0) {
+    if (om != silent && p.resume.empty()) printf("Using seed %lu.\n\n", p.seed);   // so that the run can be repeated
+    bool success = true;
+    Array *array;
+    if (p.portfolio > 1) array = run_portfolio(&p, &success);
+    else {
+        array = new Array(&p);  // create Array object that immediately builds appropriate data structures
+        if (array->score == 0) {
+            delete array;
+            array = nullptr;
+        } else {
+            if (p.resume.empty()) array->add_given_rows(&p);    // rows from the input file come first
+            else if (!array->resume(p.resume)) {    // the checkpoint has them already
+                delete array;
+                return 1;
+            }
+            if (!p.checkpoint.empty()) {    // save a checkpoint before stopping, or whenever asked
+                std::signal(SIGTERM, on_signal);
+                std::signal(SIGUSR1, on_signal);
+            }
+            array->print_stats(true);   // report initial state of array
+            success = generate(&p, array, nullptr);
+        }
+    }
+    if (array != nullptr && signalled == SIGTERM && array->score > 0) {
+        printf("Stopped by SIGTERM. To pick up where this left off, rerun with --resume %s.\n\n",
+            p.checkpoint.c_str());
+        delete array;
+        return 1;
+    }
+    if (array == nullptr) {
         printf("Nothing to do.\n\n");
         return 0;
     }
 
-    array.print_stats(true);        // report initial state of array
+    if (array->score == 0 && p.prune != prune_off) array->prune_rows(p.prune);  // only worth it once complete
+    if (array->score == 0 && p.anneal > 0) array->anneal(p.anneal);
+    int exit_code = print_results(&p, array, success);
+    delete array;
+    return exit_code;
+}
+
+/* SUB METHOD: generate - adds rows to an array until it is complete, or until it cannot be completed
+ *
+ * parameters:
+ * - p: Parser object that has already had its process_input() method called
+ * - array: Array object that has already been constructed and still has problems to solve
+ * - best: shared by the arrays of a portfolio, the smallest rows*p->portfolio + stream of any array finished
+ *   so far, so that of two arrays with the fewest rows, the one with the lower stream is the smallest; the
+ *   array is given up on once it could no longer be the smallest, since it would need at least one more row
+ *   to finish; nullptr if the array is the only one being generated
+ * - if p->checkpoint is set, a checkpoint is saved whenever p->checkpoint_rows rows have been added or
+ *   p->checkpoint_seconds seconds have passed since the last one, and after the row in progress when SIGTERM
+ *   or SIGUSR1 is received; after SIGTERM, generation stops there
+ *
+ * returns:
+ * - false if the array appears impossible to complete with the requested properties, true otherwise
+*/
+static bool generate(Parser *p, Array *array, std::atomic<uint64_t> *best)
+{
+    if (p->engine == ipog) {    // build the whole array a column at a time instead
+        array->add_ipog_rows();
+        array->print_stats();
+    } else if (array->add_orthogonal_rows()) array->print_stats();    // saves building the first rows
     uint64_t prev_score;            // for comparing to current score to see if nothing is changing
     uint8_t no_change_counter = 0;  // need this to stop an infinite loop if the array cannot be completed
-    while (array.score > 0) {       // add rows until the array is complete
-        prev_score = array.score;   // needed for catching impossible scenarios
-        array.add_row();            // add another row
-        if (array.score == prev_score) no_change_counter++;
+    uint64_t rows_since = 0;        // rows added since the last checkpoint
+    std::chrono::steady_clock::time_point last_saved = std::chrono::steady_clock::now();
+    while (array->score > 0) {      // add rows until the array is complete
+        if (best != nullptr && (array->size() + 1)*p->portfolio + array->stream > best->load()) break;
+        prev_score = array->score;  // needed for catching impossible scenarios
+        array->add_row();           // add another row
+        if (array->score == prev_score) no_change_counter++;
         else no_change_counter = 0;
         if (no_change_counter > 10) break;
-        array.print_stats();        // report current state of array
+        array->print_stats();       // report current state of array
+        if (p->checkpoint.empty()) continue;
+        int received = signalled;
+        if (received == SIGUSR1) signalled = 0;
+        std::chrono::steady_clock::time_point now = std::chrono::steady_clock::now();
+        if (++rows_since == p->checkpoint_rows || received != 0 || (p->checkpoint_seconds > 0 &&
+            now - last_saved >= std::chrono::seconds(p->checkpoint_seconds))) {
+            array->save_checkpoint(p->checkpoint);
+            rows_since = 0;
+            last_saved = now;
+        }
+        if (received == SIGTERM) break;
+    }
+    if (best != nullptr && array->score == 0) {     // share the new best, if it is one
+        uint64_t key = array->size()*p->portfolio + array->stream;
+        uint64_t known = best->load();
+        while (key < known && !best->compare_exchange_weak(known, key)) {}
+    }
+    return no_change_counter == 0;
+}
+
+/* SUB METHOD: run_portfolio - generates several arrays at once, each in its own thread with its own stream
+ * - the arrays are generated without printing anything, since their output would be interleaved
+ * - which array is kept does not depend on how the threads happen to be scheduled, since one given up on
+ *   could not have been kept anyway
+ * - unless the threads option was given, the cores are split evenly among the arrays
+ *
+ * parameters:
+ * - p: Parser object that has already had its process_input() method called; p->portfolio is the number of
+ *   arrays to generate, each drawing from its own stream of p->seed
+ * - success: pointer to set to false if no array could be completed, true otherwise
+ *
+ * returns:
+ * - the finished array with the fewest rows, or if none could be finished, the one closest to complete;
+ *   nullptr if there was nothing to do
+*/
+static Array *run_portfolio(Parser *p, bool *success)
+{
+    debug_mode debug = p->debug; verb_mode v = p->v; out_mode o = p->o; uint64_t threads = p->threads;
+    p->debug = d_off; p->v = v_off; p->o = silent;  // the arrays are constructed with these
+    if (threads == 0) {
+        uint64_t cores = std::thread::hardware_concurrency();  // 0 if it cannot tell
+        p->threads = std::max(static_cast<uint64_t>(1), cores/p->portfolio);
+    }
+    if (o != silent) printf("Generating %lu arrays at once....\n\n", p->portfolio);
+
+    std::vector<Array*> arrays(p->portfolio, nullptr);
+    std::atomic<uint64_t> best(UINT64_MAX);
+    std::vector<std::thread> members;
+    for (uint64_t member = 0; member < p->portfolio; member++) {
+        members.emplace_back([&, member]() {
+            arrays[member] = new Array(p, member);
+            if (arrays[member]->score == 0) return;
+            arrays[member]->add_given_rows(p);
+            generate(p, arrays[member], &best);
+        });
+    }
+    for (std::thread &member : members) member.join();
+    p->debug = debug; p->v = v; p->o = o; p->threads = threads;
+
+    Array *kept = arrays[0];    // prefer finished arrays, then fewer rows, then lower scores, then lower streams
+    for (Array *array : arrays) {
+        if ((array->score == 0) != (kept->score == 0)) {
+            if (array->score == 0) kept = array;
+        } else if (array->score == 0 ? array->size() < kept->size() : array->score < kept->score) kept = array;
     }
-    return print_results(&p, &array, (no_change_counter == 0));
+    for (Array *array : arrays) if (array != kept) delete array;
+    if (kept->score == 0 && kept->size() == 0) {    // every array was complete from the start
+        delete kept;
+        return nullptr;
+    }
+    *success = kept->score == 0;
+    if (o != silent) printf("The smallest array has %lu rows, and was generated from stream %lu.\n\n",
+        kept->size(), kept->stream);
+    return kept;
 }
 
 /* SUB METHOD: print_results - prints the completion status after the array is finished being generated
@@ -141,17 +282,35 @@ static int print_results(Parser *p, Array *array, bool success)
     return 0;
 }
 
+/* HELPER METHOD: on_signal - notes that SIGTERM or SIGUSR1 was received, for generate() to act on
+ * 
+ * parameters:
+ * - signal_number: the signal received
+ * 
+ * returns:
+ * - void, but after the method finishes, signalled will be set; a SIGTERM already noted is never replaced
+*/
+static void on_signal(int signal_number)
+{
+    if (signalled != SIGTERM) signalled = signal_number;
+}
+
 /* HELPER METHOD: debug_print - prints the introductory status when debug mode is enabled
  * 
  * parameters:
  * - d: value of d read from the command line (default should be 1)
  * - t: value of t read from the command line (default should be 2)
  * - delta: value of δ read from the command line (default should be 1)
+ * - threads: value of --threads read from the command line (default should be 0, meaning one per core)
+ * - beam: value of --beam read from the command line (default should be 1, meaning no beam search)
+ * - depth: value of --depth read from the command line (default should be 1)
+ * - engine: value of --engine read from the command line (default should be greedy)
  * 
  * returns:
  * - void; simply prints to console
 */
-static void debug_print(int d, int t, int delta) {
+static void debug_print(int d, int t, int delta, uint64_t threads, uint64_t beam, uint64_t depth,
+    engine_mode engine) {
     int pid = getpid();
     printf("==%d== Debug mode is enabled. Look for liness preceeded by the PID.\n", pid);
     if (vm == v_off) printf("==%d== Verbose mode: disabled\n", pid);
@@ -160,6 +319,13 @@ static void debug_print(int d, int t, int delta) {
     else if (om == halfway) printf("==%d== Output mode: halfway\n", pid);
     else if (om == silent) printf("==%d== Output mode: silent\n", pid);
     else printf("==%d== Output mode: UNDEFINED\n", pid);
+    if (threads == 0) printf("==%d== Threads: one per core\n", pid);
+    else printf("==%d== Threads: %lu\n", pid, threads);
+    if (beam == 1) printf("==%d== Beam search: disabled\n", pid);
+    else printf("==%d== Beam search: width %lu, depth %lu\n", pid, beam, depth);
+    if (engine == density) printf("==%d== Engine: density\n", pid);
+    else if (engine == ipog) printf("==%d== Engine: ipog\n", pid);
+    else printf("==%d== Engine: greedy\n", pid);
     if (pm == all) {
         printf("==%d== Generating: coverage, location, detection\n", pid);
         printf("==%d== Using d = %d, t = %d, δ = %d\n", pid, d, t, delta);
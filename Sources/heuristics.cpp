@@ -1,5 +1,5 @@
 /* Array-Generator by Isaac Jung
-Last updated 10/12/2022
+Last updated 10/16/2026
 
 |===========================================================================================================|
 |   This file contains definitions for methods belonging to the Array class which are declared in array.h.  |
@@ -9,48 +9,312 @@ Last updated 10/12/2022
 */
 
 #include "array.h"
+#include <algorithm>
+#include <functional>
+#include <limits>
 
 /* SUB METHOD: add_row - adds a new row to the array using some predictive and scoring logic
  * - simply an interface for adding a row; method itself simply decides which heuristic to use
+ * - when the scheduler has asked for a duel, the challenging heuristic builds a row as well, each row is tried
+ *   out without being kept, and the one that would leave the lower score is added
+ * - with a beam width above 1, the row is instead the first of the best few rows found by beam_search()
+ * - this is the only place rows are measured for the scheduler; rows added any other way (seeded, given, or
+ *   replayed from a checkpoint) go straight to update_array(), so they never count toward a heuristic
  * 
  * returns:
  * - void, but after the method finishes, the array will have a new row appended to its end
 */
 void Array::add_row()
 {
-    // choose a new random order for the column iterations this round
+    if (heuristic_in_use == none && num_tests > 0) update_heuristic();  // rows were seeded, so skip the random one
+    row_start_score = score;    // so that update_heuristic() can measure this row
+    row_start_work = total_work();
+    shuffle_permutation();      // choose a new random order for the column iterations this round
+
+    int *new_row;
+    if (beam_width > 1) new_row = beam_search();
+    else {
+        new_row = build_row();
+        if (heuristic_challenging != none) {
+            uint64_t challenger_start = total_work();
+            double favorite_work = static_cast<double>(challenger_start - row_start_work);
+            prop_mode favorite = heuristic_in_use;
+            heuristic_in_use = heuristic_challenging;   // so that the challenger's row is built the same way
+            int *challenger_row = build_row();
+            double challenger_work = static_cast<double>(total_work() - challenger_start);
+            heuristic_in_use = favorite;
+            if (settle_duel(new_row, favorite_work, challenger_row, challenger_work))
+                std::swap(new_row, challenger_row);
+            delete[] challenger_row;
+        }
+    }
+    update_array(new_row);
+    update_heuristic();
+}
+
+/* HELPER METHOD: shuffle_permutation - chooses a new random order for the column iterations
+*/
+void Array::shuffle_permutation()
+{
     for (uint64_t size = num_factors; size > 0; size--) {
-        int rand_idx = rand() % static_cast<int>(size);
+        int rand_idx = static_cast<int>(rng.below(size));
         int temp = permutation[size - 1];
         permutation[size - 1] = permutation[rand_idx];
         permutation[rand_idx] = temp;
-    }   // at this point, permutation should be shuffled
+    }
+}
+
+/* HELPER METHOD: settle_duel - tries out a row from the favorite and one from the challenger, and tells the
+ * scheduler how they did
+ * 
+ * parameters:
+ * - favorite_row: row built by heuristic_in_use
+ * - favorite_work: work done building it (see total_work())
+ * - challenger_row: row built by heuristic_challenging, from the same state
+ * - challenger_work: work done building it
+ * 
+ * returns:
+ * - true if the challenger's row would leave a lower score than the favorite's, false otherwise
+*/
+bool Array::settle_duel(int *favorite_row, double favorite_work, int *challenger_row, double challenger_work)
+{
+    uint64_t favorite_after = score_after(favorite_row);
+    uint64_t challenger_after = score_after(challenger_row);
+    scheduler.duel(heuristic_challenging, score, challenger_after, challenger_work,
+        favorite_after, favorite_work);
+    return challenger_after < favorite_after;
+}
+
+/* SUB METHOD: beam_search - looks ahead several rows to choose the next one
+ * - keeps the beam_width best partial arrays (sequences of rows that could be added next), starting from none;
+ *   each round, every one of them is extended by each of up to beam_width rows built for it by the heuristic
+ *   in use, and the best beam_width of the results are kept; after beam_depth rounds, the first row of the
+ *   best one is chosen
+ * - a partial array is scored by adding up score_row() for each of its rows, with the rows before it added
+ * - partial arrays are not copies of the Array; each one's rows are added with keep == false while it is
+ *   extended, then rolled back, and its new rows are scored in parallel by the workers in the pool
+ * - in a duel, the challenger builds rows for the first round as well, and the best row from each side
+ *   settles it (see settle_duel()); only the winner's rows are extended, as in add_row()
+ * - rows are only scored, and ties only broken, when there is a choice to make, so a beam of width 1 and
+ *   depth 1 chooses the same row as add_row() would without one
+ * 
+ * returns:
+ * - a pointer to the first element in the array that represents the chosen row
+*/
+int *Array::beam_search()
+{
+    std::vector<int*> made; // every row built, so that those not chosen can be freed at the end
+    std::vector<BeamEntry> beam(1), next;
+    beam[0].gain = 0;
+    std::vector<int*> candidates;
+    std::vector<int64_t> row_gains;
+    for (uint64_t round = 0; round < beam_depth; round++) {
+        next.clear();
+        for (BeamEntry &entry : beam) {
+            for (int *row : entry.rows) update_array(row, false);
+            if (score == 0) {   // this one already completes the array, so there is nothing to extend
+                rollback();
+                next.push_back(entry);
+                continue;
+            }
+
+            // build the rows to extend it with, and score them all at once
+            candidates.clear();
+            uint64_t start = total_work();
+            build_candidates(beam_width, &candidates);
+            uint64_t num_favorite = candidates.size();
+            double favorite_work = static_cast<double>(total_work() - start)/num_favorite;
+            bool dueling = round == 0 && heuristic_challenging != none;
+            double challenger_work = 0;
+            if (dueling) {
+                prop_mode favorite = heuristic_in_use;
+                heuristic_in_use = heuristic_challenging;   // so that the challenger's rows are built the same way
+                start = total_work();
+                build_candidates(beam_width, &candidates);
+                challenger_work = static_cast<double>(total_work() - start)/(candidates.size() - num_favorite);
+                heuristic_in_use = favorite;
+            }
+            made.insert(made.end(), candidates.begin(), candidates.end());
+            row_gains.assign(candidates.size(), 0);
+            if (beam.size() > 1 || candidates.size() > (dueling ? 2 : 1))  // only score rows there is a choice of
+                pool->run(candidates.size(), [&](uint64_t idx, uint64_t worker) {
+                    row_gains[idx] = score_row(candidates[idx], &workspaces[worker]);
+                });
+            rollback();
+
+            uint64_t first = 0, last = candidates.size();
+            if (dueling) {  // pit the best row of each side against each other; the loser's rows go no further
+                uint64_t best_favorite = 0, best_challenger = num_favorite;
+                for (uint64_t idx = 0; idx < candidates.size(); idx++) {
+                    uint64_t &best = idx < num_favorite ? best_favorite : best_challenger;
+                    if (row_gains[idx] > row_gains[best]) best = idx;
+                }
+                if (settle_duel(candidates[best_favorite], favorite_work, candidates[best_challenger],
+                    challenger_work)) first = num_favorite;
+                else last = num_favorite;
+            }
+            for (uint64_t idx = first; idx < last; idx++) {
+                next.push_back(entry);
+                next.back().rows.push_back(candidates[idx]);
+                next.back().gain += row_gains[idx];
+            }
+        }
+
+        // keep the best ones, breaking ties randomly
+        Selector kept;
+        kept.reset(beam_width, next.size() > 1 ? rng() : 0);  // nothing to break ties between otherwise
+        for (uint64_t idx = 0; idx < next.size(); idx++) kept.offer(next[idx].gain, idx);
+        beam.clear();
+        for (const Candidate &candidate : kept.best()) beam.push_back(next[candidate.index]);
+    }
+
+    int *chosen = beam[0].rows[0];
+    for (int *row : made) if (row != chosen) delete[] row;
+    return chosen;
+}
+
+/* HELPER METHOD: build_candidates - builds several different rows with the heuristic in use
+ * - heuristic_all() finds the best few rows in one search; every other heuristic is simply run again with a
+ *   new column order, and rows it has already built are thrown out
+ * 
+ * parameters:
+ * - count: how many rows to build at most; at least 1 is always built
+ * - candidates: where to add the rows; rows already in it are left alone
+ * 
+ * returns:
+ * - void, but after the method finishes, the rows will have been added to candidates
+*/
+void Array::build_candidates(uint64_t count, std::vector<int*> *candidates)
+{
+    uint64_t first = candidates->size();
+    if (heuristic_in_use == all) {
+        T *locked = nullptr;
+        Interaction *planted = nullptr;
+        int *row = initialize_row(&locked, &planted);
+        candidates->push_back(row);
+        heuristic_all(row, count, candidates);
+        return;
+    }
+    for (uint64_t built = 0; built < count; built++) {
+        if (built > 0) shuffle_permutation();
+        int *row = build_row();
+        bool repeated = false;
+        for (uint64_t idx = first; idx < candidates->size() && !repeated; idx++)
+            repeated = std::equal(row, row + num_factors, (*candidates)[idx]);
+        if (repeated) delete[] row;
+        else candidates->push_back(row);
+    }
+}
+
+/* SUB METHOD: build_row - initializes a row and tweaks it, both based on the heuristic in use
+ * 
+ * returns:
+ * - a pointer to the first element in the array that represents the row
+*/
+int *Array::build_row()
+{
+    if (heuristic_in_use == c_only && engine == density) return density_row();  // already as good as it gets
 
-    // choose how to initialize the new row based on current heuristic to be used
-    int *new_row;
     T *locked = nullptr;
+    Interaction *planted = nullptr;
+    int *new_row = initialize_row(&locked, &planted);
+    
+    // tweak the row based on the current heuristic
+    tweak_row(new_row, locked, planted);
+    return new_row;
+}
+
+/* SUB METHOD: initialize_row - initializes a row the way the heuristic in use starts from
+ * - build_row() and build_candidates() both start here, so a beam search starts its rows the same way as
+ *   adding one row at a time does
+ * 
+ * parameters:
+ * - locked: where to put the T set placed in the row, if any; left alone otherwise
+ * - planted: where to put the Interaction placed in the row, if any; left alone otherwise
+ * 
+ * returns:
+ * - a pointer to the first element in the array that represents the row
+*/
+int *Array::initialize_row(T **locked, Interaction **planted)
+{
     switch (heuristic_in_use) {
         case c_only:
         case c_and_l:
         case c_and_d:
-            new_row = initialize_row_S();
-            break;
+            return initialize_row_S();
         case l_only:
         case l_and_d:
-            new_row = initialize_row_T(&locked);
-            break;
+            return initialize_row_T(locked);
         case d_only:
-            // TODO: implement initialize_row_I() and call that here, then break
+            return initialize_row_I(planted);
         case all:
         case none:
         default:
-            new_row = initialize_row_R();
-            break;
-    }   // at this point, new row should be initialized with values
-    
-    // tweak the row based on the current heuristic and then add to the array
-    tweak_row(new_row, locked);
-    update_array(new_row);
+            return initialize_row_R();
+    }
+}
+
+/* SUB METHOD: score_after - finds out what the score would be if a row was added, without adding it
+ * 
+ * parameters:
+ * - row: integer array representing a row being considered for adding to the array
+ * 
+ * returns:
+ * - the score the array would have
+*/
+uint64_t Array::score_after(int *row)
+{
+    update_array(row, false);
+    uint64_t after = score;
+    rollback();
+    return after;
+}
+
+/* SUB METHOD: density_row - creates a row for coverage one column at a time, without any randomness
+ * - this is the deterministic density algorithm: each column, in order, is fixed to the value that maximizes
+ *   the number of uncovered Interactions the row is expected to cover, were the columns after it random
+ * - an uncovered Interaction still agreeing with the columns fixed so far is covered by a random completion
+ *   with probability 1 over the product of the levels of its columns not yet fixed; its tuple's columns come
+ *   in order and the last varies fastest, so those agreeing with column c at value v and with the columns
+ *   before c form one block of ranks, whose length is c's place value in the tuple
+ * - the expectation never drops as columns are fixed, so the row covers at least as many Interactions as a
+ *   random row would on average, and so at least one while any are left
+ * - ties go to the value whose Single has the most issues (weighted as in file_singles()), then the lowest
+ * 
+ * returns:
+ * - a pointer to the first element in the array that represents the row
+*/
+int *Array::density_row()
+{
+    int *new_row = new int[num_factors]{0};
+    std::vector<double> expected;
+    for (uint64_t col = 0; col < num_factors; col++) {
+        uint64_t level = factors[col]->level;
+        expected.assign(level, 0);
+        for (uint64_t idx = column_starts[col]; idx < column_starts[col+1]; idx++) {
+            uint64_t tuple = column_tuples[idx], radix = column_radices[idx], base = tuple_offsets[tuple];
+            for (uint64_t j = 0; j < t && tuple_columns[tuple*t + j] != col; j++)  // the columns fixed already
+                base += static_cast<uint64_t>(new_row[tuple_columns[tuple*t + j]])*tuple_radices[tuple*t + j];
+            for (uint64_t value = 0; value < level; value++) {
+                uint64_t uncovered_count = 0;
+                for (uint64_t rank = base + value*radix; rank < base + (value + 1)*radix; rank++)
+                    if (!interactions[rank]->is_covered) uncovered_count++;
+                expected[value] += static_cast<double>(uncovered_count)/static_cast<double>(radix);
+            }
+            work += level*radix;
+        }
+        int64_t best_issues = -1;
+        for (uint64_t value = 0; value < level; value++) {
+            Single *s = factors[col]->singles[value];
+            int64_t issues = static_cast<int64_t>(s->c_issues) + s->l_issues + 3*static_cast<int64_t>(s->d_issues);
+            double best = expected[static_cast<uint64_t>(new_row[col])];
+            if (value == 0 || expected[value] > best || (expected[value] == best && issues > best_issues)) {
+                new_row[col] = static_cast<int>(value);
+                best_issues = issues;
+            }
+        }
+    }
+    return new_row;
 }
 
 /* SUB METHOD: initialize_row_R - creates a randomly generated row
@@ -62,11 +326,13 @@ int *Array::initialize_row_R()
 {
     int *new_row = new int[num_factors];
     for (uint64_t i = 0; i < num_factors; i++)
-        new_row[i] = static_cast<uint64_t>(rand()) % factors[i]->level;
+        new_row[i] = static_cast<int>(rng.below(factors[i]->level));
     return new_row;
 }
 
 /* SUB METHOD: initialize_row_S - creates a row by considering which Singles have the most issues
+ * - one Interaction that is not covered yet, picked at random from the uncovered worklist, is then planted
+ *   over the row, so that the row covers something new however many of the Singles' issues are elsewhere
  * 
  * returns:
  * - a pointer to the first element in the array that represents the row
@@ -74,6 +340,7 @@ int *Array::initialize_row_R()
 int* Array::initialize_row_S()
 {
     int *new_row = new int[num_factors]{0};
+    file_singles(); // bring every Factor's queue up to date with the rows added since the last call
 
     // greedily select the values that appear to need the most attention
     for (uint64_t col = 0; col < num_factors; col++) {
@@ -81,24 +348,17 @@ int* Array::initialize_row_S()
         if ((p == all && dont_cares[permutation[col]] == all) ||
             (p == c_and_l && dont_cares[permutation[col]] == c_and_l) ||
             (p == c_only && dont_cares[permutation[col]] == c_only)) {
-            new_row[permutation[col]] = static_cast<uint64_t>(rand()) % factors[permutation[col]]->level;
+            new_row[permutation[col]] = static_cast<int>(rng.below(factors[permutation[col]]->level));
             continue;
         }
-        // assume 0 is the worst to start, then check if any others are worse
-        Single *worst_single = factors[permutation[col]]->singles[0];
-        int worst_score = static_cast<int64_t>(worst_single->c_issues) + worst_single->l_issues + 
-            3*static_cast<int64_t>(worst_single->d_issues);
-        for (uint64_t val = 1; val < factors[permutation[col]]->level; val++) {
-            Single *cur_single = factors[permutation[col]]->singles[val];
-            int cur_score = static_cast<int64_t>(cur_single->c_issues) + cur_single->l_issues +
-                3*static_cast<int64_t>(cur_single->d_issues);
-            if (cur_score > worst_score || (cur_score == worst_score && rand() % 2 == 0)) {
-                worst_single = cur_single;
-                worst_score = cur_score;
-            }
-        }
-        new_row[permutation[col]] = worst_single->value;
+        // take the value whose Single has the most issues (for ties, choose randomly from among the worst)
+        SparseWorklist &queue = factors[permutation[col]]->queue;
+        new_row[permutation[col]] = queue.random(queue.top(), &rng);
     }   // entire row is now initialized based on the greedy approach
+
+    // plant an Interaction that is still uncovered, so that the row is sure to cover something new
+    if (uncovered.size() > 0)
+        for (Single *s : interactions[uncovered.random(0, &rng)]->singles) new_row[s->factor] = s->value;
     return new_row;
 }
 
@@ -110,35 +370,31 @@ int* Array::initialize_row_S()
 int *Array::initialize_row_T(T **locked)
 {
     int *new_row = initialize_row_R();
-    
-    int64_t worst_count = INT64_MIN;
-    std::vector<T*> worst_sets; // there could be ties for the worst
-    for (T *t_set : sets) {
-        //t_set->rows.size()==0
-        if (static_cast<int64_t>(t_set->location_conflicts.size()) >= worst_count) {    // worse or tied
-            if (static_cast<int64_t>(t_set->location_conflicts.size()) > worst_count) { // strictly worse
-                worst_count = t_set->location_conflicts.size();
-                worst_sets.clear();
-            }
-            worst_sets.push_back(t_set);
-        }
-    }
 
     // choose the set with most conflicts (for ties, choose randomly from among those tied for the worst)
-    *locked = worst_sets.at(static_cast<uint64_t>(rand()) % worst_sets.size());
+    if (unlocated.size() > 0) *locked = sets[unlocated.random(unlocated.top(), &rng)];
+    else *locked = sets[rng.below(sets.size())];  // nothing left to locate
     for (Single *s : (*locked)->singles) new_row[s->factor] = s->value;
     return new_row;
 }
 
 /* SUB METHOD: initialize_row_I - creates a row by considering which Interactions have the lowest separation
+ * 
+ * parameters:
+ * - planted: set to the Interaction placed in the row, or nullptr if every Interaction is already detectable
  * 
  * returns:
  * - a pointer to the first element in the array that represents the row
 */
-int *Array::initialize_row_I()
+int *Array::initialize_row_I(Interaction **planted)
 {
-    int *new_row = new int[num_factors];
-    // TODO: logic
+    int *new_row = initialize_row_R();
+    *planted = nullptr;
+    if (undetectable.size() == 0) return new_row;   // nothing left to detect
+
+    // choose the Interaction least separated from some T set (for ties, choose randomly from among the worst)
+    *planted = interactions[undetectable.random(undetectable.top(), &rng)];
+    for (Single *s : (*planted)->singles) new_row[s->factor] = s->value;
     return new_row;
 }
 
@@ -150,7 +406,7 @@ int *Array::initialize_row_I()
  * returns:
  * - void, but after the method finishes, the row may be modified in an attempt to satisfy more issues
 */
-void Array::tweak_row(int *row, T *locked)
+void Array::tweak_row(int *row, T *locked, Interaction *planted)
 {
     switch (heuristic_in_use) {
         case c_only:
@@ -163,7 +419,7 @@ void Array::tweak_row(int *row, T *locked)
             heuristic_l_only(row, locked);
             break;
         case d_only:
-            heuristic_d_only(row);
+            heuristic_d_only(row, planted);
             break;
         case all:
             heuristic_all(row);
@@ -188,28 +444,19 @@ void Array::tweak_row(int *row, T *locked)
 void Array::heuristic_c_only(int *row)
 {
     int *problems = new int[num_factors]{0};    // for counting how many "problems" each factor has
+    int *temp_problems = new int[num_factors];  // problems[] as it would be after changing one value
     int max_problems;   // largest value among all in the problems[] array created above
     int cur_max;    // for comparing to max_problems to see if there is an improvement
     prop_mode *dont_cares_c = new prop_mode[num_factors];   // local copy of the don't cares
     for (uint64_t col = 0; col < num_factors; col++) dont_cares_c[col] = dont_cares[col];
 
-    std::set<Interaction*> row_interactions;
-    build_row_interactions(row, &row_interactions, 0, t, "");
-    for (Interaction *i : row_interactions) {
-        if (i->rows.size() != 0) {  // Interaction is already covered
-            bool can_skip = false;  // don't account for Interactions involving already-completed factors
-            for (Single *s : i->singles)
-                if (dont_cares_c[s->factor] != none) {
-                    can_skip = true;
-                    break;
-                }
-            if (can_skip) continue;
-            for (Single *s : i->singles) // increment the problems counter for each Single involved
-                problems[s->factor]++;
-        } else {    // Interaction not covered; decrement the problems counters instead
-            for (Single *s : i->singles) problems[s->factor]--;
-        }
+    // the row's Interactions are found once here; after this, changing a value only touches the tuples of its column
+    view.resize(num_tuples);
+    for (uint64_t tuple = 0; tuple < num_tuples; tuple++) {
+        view[tuple] = interaction_rank(row, tuple);
+        count_c_problems(interactions[view[tuple]], 1, problems, dont_cares_c);
     }
+    work += num_tuples;
 
     // find out what the worst score is among the factors
     max_problems = 0;
@@ -217,6 +464,7 @@ void Array::heuristic_c_only(int *row)
         if (problems[col] > max_problems) max_problems = problems[col];
     if (max_problems == 0) {    // row is good enough as is
         delete[] problems;
+        delete[] temp_problems;
         delete[] dont_cares_c;
         return;
     }
@@ -225,269 +473,682 @@ void Array::heuristic_c_only(int *row)
     cur_max = max_problems;
     for (uint64_t col = 0; col < num_factors; col++) {  // go find any factors to change
         if (problems[permutation[col]] == max_problems) {   // found a factor to try altering
-            int *temp_problems = new int[num_factors]{0};   // deep copy problems[] because it will be mutated
-
+            int original = row[permutation[col]];
             for (uint64_t i = 1; i < factors[permutation[col]]->level; i++) {   // for every value
                 row[permutation[col]] = (row[permutation[col]] + 1) %
                     static_cast<int64_t>(factors[permutation[col]]->level); // try that value
-                std::set<Interaction*> new_interactions;    // get the new Interactions
-                build_row_interactions(row, &new_interactions, 0, t, "");
+                for (uint64_t f = 0; f < num_factors; f++) temp_problems[f] = problems[f];
 
-                cur_max = heuristic_c_helper(row, &new_interactions, temp_problems);    // test this change
+                cur_max = heuristic_c_helper(row, permutation[col], original, temp_problems, dont_cares_c);
                 if (cur_max < max_problems) {   // this change improved the score, keep it
                     delete[] problems;
-                    delete[] dont_cares_c;
                     delete[] temp_problems;
+                    delete[] dont_cares_c;
                     return;
                 }
                 cur_max = max_problems; // else this change was no good, reset and continue
             }
-            delete[] temp_problems;
-            row[permutation[col]] = (row[permutation[col]] + 1) % static_cast<int>(factors[col]->level);
+            row[permutation[col]] = original;
         }
     }
 
     // last resort, start looking for *anything* that is missing
+    int64_t missing = 0;    // how many of the row's Interactions are not covered yet
+    for (uint64_t tuple = 0; tuple < num_tuples; tuple++)
+        if (interactions[view[tuple]]->rows.empty()) missing++;
+    work += num_tuples;
     for (uint64_t col = 0; col < num_factors; col++) {  // for all factors
         if (dont_cares_c[permutation[col]] != none) continue;   // no need to check already completed factors
+        int from = row[permutation[col]];
         bool improved = false;
         for (uint64_t i = 0; i < factors[permutation[col]]->level; i++) {   // for every value
             row[permutation[col]] = (row[permutation[col]] + 1) %
                 static_cast<int64_t>(factors[permutation[col]]->level); // try that value
-            std::set<Interaction*> new_interactions;    // get the new Interactions
-            build_row_interactions(row, &new_interactions, 0, t, "");
-
-            improved = false;   // see if the change helped
-            for (Interaction *interaction : new_interactions)
-                if (interaction->rows.size() == 0) {    // the Interaction is not already covered
-                    for (Single *s : interaction->singles) dont_cares_c[s->factor] = c_only;
-                    improved = true;
-                }
+            missing += shift_view(permutation[col], from, row[permutation[col]]);
+            from = row[permutation[col]];
+
+            improved = missing > 0;   // see if the change helped
             if (improved) break;    // keep this factor as this value
         }
-        if (improved) continue;
-        row[permutation[col]] = static_cast<uint64_t>(rand()) % factors[permutation[col]]->level;
+        if (improved) {
+            for (uint64_t tuple = 0; tuple < num_tuples; tuple++)
+                if (interactions[view[tuple]]->rows.empty())    // the Interaction is not already covered
+                    for (Single *s : interactions[view[tuple]]->singles) dont_cares_c[s->factor] = c_only;
+            work += num_tuples;
+            continue;
+        }
+        row[permutation[col]] = static_cast<int>(rng.below(factors[permutation[col]]->level));
+        missing += shift_view(permutation[col], from, row[permutation[col]]);
     }
     delete[] problems;
+    delete[] temp_problems;
     delete[] dont_cares_c;
 }
 
-/* HELPER METHOD: heuristic_c_helper - performs redundant work for heuristic_c_only()
+/* HELPER METHOD: heuristic_c_helper - rescores a row for heuristic_c_only() after one of its values changed
+ * - only the tuples containing the changed column are revisited; the view is left as it was
  * 
  * parameters:
- * - row: integer array representing a row being considered for adding to the array
- * - row_interactions: set containing all Interactions present in the row
- * - problems: pointer to start of array associating each column in the row with a score of sorts
+ * - row: integer array representing a row being considered for adding to the array, with the new value in it
+ * - col: the column whose value changed
+ * - from: the value the column had before
+ * - problems: the scores associated with each column before the change, adjusted in place
+ * - dont_cares_c: heuristic_c_only()'s local copy of the don't cares
  * 
  * returns:
  * - int representing the largest value in the problems array after scoring
 */
-int Array::heuristic_c_helper(int *row, std::set<Interaction*> *row_interactions, int *problems)
+int Array::heuristic_c_helper(int *row, uint64_t col, int from, int *problems, prop_mode *dont_cares_c)
 {
-    for (Interaction *i : *row_interactions) {
-        if (i->rows.size() != 0) {  // Interaction is already covered
-            bool can_skip = false;  // don't account for Interactions involving already-completed factors
-            for (Single *s : i->singles)
-                if (s->c_issues == 0) { // one of the Singles involved in the Interaction is completed
-                    // TODO: make this check more than just c_issues?
-                    can_skip = true;
-                    break;
-                }
-            if (can_skip) continue;
-            for (Single *s : i->singles) // increment the problems counter for each Single involved
-                problems[s->factor]++;
-        } else {    // Interaction not covered; decrement the problems counters instead
-            for (Single *s : i->singles) problems[s->factor]--;
-        }
+    for (uint64_t idx = column_starts[col]; idx < column_starts[col+1]; idx++) {
+        uint64_t rank = view[column_tuples[idx]];
+        count_c_problems(interactions[rank], -1, problems, dont_cares_c);   // take back the old Interaction
+        rank = rank + static_cast<uint64_t>(row[col])*column_radices[idx] -
+            static_cast<uint64_t>(from)*column_radices[idx];
+        count_c_problems(interactions[rank], 1, problems, dont_cares_c);    // and count the new one instead
     }
+    work += 2*(column_starts[col+1] - column_starts[col]);
 
     // find out what the worst score is among the factors
     int max_problems = INT32_MIN;   // set max to a huge negative number to start
-    for (uint64_t col = 0; col < num_factors; col++) {
-        if (factors[col]->singles[row[col]]->c_issues == 0) continue;   // already completed factor
-        if (problems[col] > max_problems) max_problems = problems[col];
+    for (uint64_t c = 0; c < num_factors; c++) {
+        if (factors[c]->singles[row[c]]->c_issues == 0) continue;   // already completed factor
+        if (problems[c] > max_problems) max_problems = problems[c];
     }
     return max_problems;
 }
 
+/* HELPER METHOD: count_c_problems - adds one Interaction's share to the scores used by heuristic_c_only()
+ * - a covered Interaction counts against each factor involved, unless one of them is already completed
+ * - an uncovered Interaction counts in favor of each factor involved
+ * 
+ * parameters:
+ * - interaction: the Interaction to count
+ * - sign: 1 to add the Interaction's share, -1 to take it back out
+ * - problems: pointer to start of array associating each column in the row with a score of sorts
+ * - dont_cares_c: heuristic_c_only()'s local copy of the don't cares
+ * 
+ * returns:
+ * - void, but after the method finishes, problems[] will be updated
+*/
+void Array::count_c_problems(Interaction *interaction, int sign, int *problems, prop_mode *dont_cares_c)
+{
+    if (!interaction->rows.empty()) {   // Interaction is already covered
+        for (Single *s : interaction->singles)  // don't account for Interactions involving completed factors
+            if (dont_cares_c[s->factor] != none) return;
+        for (Single *s : interaction->singles) problems[s->factor] += sign;
+    } else {    // Interaction not covered; count against the problems counters instead
+        for (Single *s : interaction->singles) problems[s->factor] -= sign;
+    }
+}
+
+/* HELPER METHOD: shift_view - moves heuristic_c_only()'s view of the row along with a change to one value
+ * 
+ * parameters:
+ * - col: the column whose value changed
+ * - from: the value the column had before
+ * - to: the value the column has now
+ * 
+ * returns:
+ * - the change in how many of the row's Interactions are not covered yet
+*/
+int64_t Array::shift_view(uint64_t col, int from, int to)
+{
+    int64_t missing = 0;
+    for (uint64_t idx = column_starts[col]; idx < column_starts[col+1]; idx++) {
+        uint64_t &rank = view[column_tuples[idx]];
+        if (interactions[rank]->rows.empty()) missing--;
+        rank = rank + static_cast<uint64_t>(to)*column_radices[idx] - static_cast<uint64_t>(from)*column_radices[idx];
+        if (interactions[rank]->rows.empty()) missing++;
+    }
+    work += 2*(column_starts[col+1] - column_starts[col]);
+    return missing;
+}
+
 /* SUB METHOD: heuristic_l_only - middleweight heuristic that only concerns itself with location
  * - in the tradeoff between speed and better row choice, this heuristic is somewhere in the middle
  * - should be used when most, if not all, coverage problems have been solved
+ * - a class of m + n conflicting T sets, m of them in the row, is split into m*n pairs that no longer
+ *   conflict; taking one T set out of the row changes this by 2m - (m + n) - 1, so each Single of a T set in
+ *   the row is charged that much when it is positive (the class is better off with fewer of its T sets in
+ *   the row), and each Single of a T set in conflict with the locked one is charged 1 (the locked T set is
+ *   in the row, so those should stay out of it); then each column moves to its least charged value, unless
+ *   the value it has is charged no more than that
  * 
  * parameters:
  * - row: integer array representing a row being considered for adding to the array
+ * - locked: the T set placed in the row by initialize_row_T(); its columns are left alone
  * 
  * returns:
  * - void, but after the method finishes, the row may be modified in an attempt to satisfy more issues
 */
 void Array::heuristic_l_only(int *row, T *locked)
 {
-    // keep track of which columns should not be modified
-    bool *locked_factors = new bool[num_factors]{false};
+    Workspace *ws = &workspaces[0]; // the pool is idle outside of heuristic_all(), so borrow its scratch space
+    std::vector<bool> locked_factors(num_factors, false);   // columns that should not be modified
     for (Single *s : locked->singles) locked_factors[s->factor] = true;
 
-    std::map<std::string, uint64_t> scores; // create and initialize a map of every Single to a scoring
-    for (uint64_t col = 0; col < num_factors; col++)
-        for (uint64_t val = 0; val < factors[col]->level; val++)
-            scores.insert({"f" + std::to_string(col) + "," + std::to_string(val), 0});
-    
-    for (T *conflict : locked->location_conflicts)  // for every conflicting T set,
-        for (Single *s : conflict->singles) // for every Single in that conflicting set,
-            scores.at(s->to_string())++;    // increase the score of that Single
+    // find the T sets in the row, and how many of each class of conflicting T sets are among them
+    build_row_interactions(row, &ws->row_interactions);
+    ws->row_sets.clear();
+    for (Interaction *i : ws->row_interactions)
+        for (T *t_set : i->sets) {
+            if (ws->row_set_ranks.test(t_set->rank)) continue;
+            ws->row_set_ranks.set(t_set->rank);
+            ws->row_sets.push_back(t_set);
+        }
+    if (ws->class_counts.size() < location.num_classes()) {   // score_row() counts on both being the same size
+        ws->class_counts.resize(location.num_classes(), 0);
+        ws->class_weights.resize(location.num_classes(), 0);
+    }
+    for (T *t_set : ws->row_sets) {
+        if (t_set->is_locatable || t_set->rows.empty()) continue;   // only T sets that have occurred conflict
+        uint64_t c = location.class_of[t_set->rank];
+        if (ws->class_counts[c]++ == 0) ws->touched.push_back(c);
+    }
 
-    // a larger value in the scores map means the Single is involved in more location conflicts
+    // charge the Singles of T sets whose class would be split more evenly without them
+    for (T *t_set : ws->row_sets) {
+        if (t_set == locked || t_set->is_locatable || t_set->rows.empty()) continue;
+        uint64_t c = location.class_of[t_set->rank];
+        int64_t excess = 2*static_cast<int64_t>(ws->class_counts[c]) -
+            static_cast<int64_t>(location.size_of(c)) - 1;
+        if (excess > 0) for (Single *s : t_set->singles) single_scores[s->rank] += excess;
+    }
+    if (!locked->rows.empty()) {    // T sets that have never occurred are not in conflict with each other
+        uint64_t locked_class = location.class_of[locked->rank];
+        for (uint64_t idx = location.starts[locked_class]; idx < location.ends[locked_class]; idx++) {
+            T *conflict = sets[location.elements[idx]]; // for every conflicting T set,
+            if (conflict == locked) continue;
+            for (Single *s : conflict->singles) single_scores[s->rank]++;  // charge every Single in it
+        }
+    }
+    for (uint64_t c : ws->touched) ws->class_counts[c] = 0;
+    ws->touched.clear();
+    for (T *t_set : ws->row_sets) ws->row_set_ranks.reset(t_set->rank);
+    work += ws->row_interactions.size() + 4*ws->row_sets.size();   // found, counted, charged, and reset
+    if (!locked->rows.empty()) work += location.size_of(location.class_of[locked->rank]);
+
+    // a larger score means the Single keeps more location conflicts from being split apart
     for (uint64_t col = 0; col < num_factors; col++) {
-        if (locked_factors[col]) continue;
-        uint64_t best_val;
-        uint64_t best_val_score = 0;
+        Single **col_singles = factors[col]->singles;
+        int64_t cur_score = single_scores[col_singles[row[col]]->rank];    // others must be charged less
+        int64_t best_score = cur_score;
+        int best_val = row[col];
+        uint64_t ties = 0;
         for (uint64_t val = 0; val < factors[col]->level; val++) {
-            uint64_t val_score = scores.at("f" + std::to_string(col) + "," + std::to_string(val));
-            if (val_score > best_val_score) {
-                best_val = val;
-                best_val_score = val_score;
+            int64_t &val_score = single_scores[col_singles[val]->rank];
+            if (!locked_factors[col] && val_score < cur_score && val_score <= best_score) {
+                if (val_score < best_score) ties = 0;   // strictly better
+                if (rng.below(++ties) == 0) {  // keep each tied value equally likely
+                    best_score = val_score;
+                    best_val = static_cast<int>(val);
+                }
             }
+            val_score = 0;  // leave the scratch space clean for the next call
         }
-        if (best_val_score != 0) row[col] = best_val;   // else allow it to remain random
+        row[col] = best_val;
     }
-    delete[] locked_factors;
 }
 
 /* SUB METHOD: heuristic_d_only - middleweight heuristic that only concerns itself with detection
  * - in the tradeoff between speed and better row choice, this heuristic is somewhere in the middle
  * - should be used when detection problems are all that remain
+ * - the row gives the planted Interaction one more row of separation from every T set that does not occur
+ *   in it, so every other column is set greedily, in permutation order, to the value bringing in the fewest
+ *   T sets that the planted Interaction still needs separating from (weighted by how much separation each
+ *   one lacks); ties go to the value whose Single has the most detection issues, then to a random one
  * 
  * parameters:
  * - row: integer array representing a row being considered for adding to the array
+ * - planted: the Interaction placed in the row by initialize_row_I(); its columns are left alone
  * 
  * returns:
  * - void, but after the method finishes, the row may be modified in an attempt to satisfy more issues
 */
-void Array::heuristic_d_only(int *row)
+void Array::heuristic_d_only(int *row, Interaction *planted)
 {
+    if (planted == nullptr) return; // every Interaction is already detectable
+    std::vector<uint64_t> needs(sets.size());   // per T set, how much separation it still lacks
+    for (T *t_set : sets) needs[t_set->rank] = delta - separation.get(planted->rank, t_set->rank);
+    work += sets.size();
+    std::vector<bool> fixed(num_factors, false);
+    for (Single *s : planted->singles) fixed[s->factor] = true;
+
+    std::vector<uint64_t> ranks;    // per tuple of the column, the rank of the row's current Interaction
+    for (uint64_t col = 0; col < num_factors; col++) {
+        uint64_t c = permutation[col];
+        if (fixed[c]) continue;
+        ranks.clear();
+        for (uint64_t idx = column_starts[c]; idx < column_starts[c+1]; idx++)
+            ranks.push_back(interaction_rank(row, column_tuples[idx]) -
+                static_cast<uint64_t>(row[c])*column_radices[idx]); // as if the column were at value 0
 
+        uint64_t best_cost = UINT64_MAX;
+        uint64_t best_issues = 0;
+        uint64_t ties = 0;
+        for (uint64_t val = 0; val < factors[c]->level; val++) {
+            uint64_t cost = 0;
+            for (uint64_t idx = column_starts[c]; idx < column_starts[c+1]; idx++) {
+                Interaction *i = interactions[ranks[idx - column_starts[c]] + val*column_radices[idx]];
+                for (T *t_set : i->sets) cost += needs[t_set->rank];
+                work += 1 + i->sets.size();
+            }
+            uint64_t issues = factors[c]->singles[val]->d_issues;
+            if (cost > best_cost || (cost == best_cost && issues < best_issues)) continue;
+            if (cost < best_cost || issues > best_issues) ties = 0; // strictly better
+            if (rng.below(++ties) != 0) continue;  // keep each tied value equally likely
+            best_cost = cost;
+            best_issues = issues;
+            row[c] = static_cast<int>(val);
+        }
+    }
 }
 
 /* SUB METHOD: heuristic_all - heavyweight heuristic that tries to solve the most problems possible
  * - in the tradeoff between speed and better row choice, this heuristic is towards the row choice extreme
  * - does the deepest inspection of all the heuristics; therefore, should not be used till close to complete
+ * - every possible row is a candidate; each worker builds its candidates in place, and the Selector copies
+ *   the ones it keeps, since there are far too many rows to number once the levels multiply past 2^64
+ * - the candidates are searched as a tree, assigning one column per level in permutation order; a subtree
+ *   is skipped when an upper bound on the score of any row in it falls short of a bar (see prepare_bounds()),
+ *   which never skips a row that ties for the best
+ * - the subtrees below the first few levels are scored in parallel by the workers in the pool; first, one row
+ *   is found in each by always taking its most promising value, and the best of these rows (and the given
+ *   row) set the bar for all of them; after that, each subtree is pruned only by that bar and the rows found
+ *   in it, so what is found never depends on timing or on how many workers there are
+ * - the search is bounded, not exact: each subtree is searched only until it has done its share of
+ *   search_work (counted as in total_work()), after which the best rows found so far are taken; only when
+ *   no subtree runs out is the result the same as if every row had been scored
  * 
  * parameters:
  * - row: integer array representing a row up for consideration for appending to the array
+ * - keep: how many of the best rows to find; 1 by default
+ * - runners_up: where to add new rows for the second best onward, if keep is more than 1
  * 
  * returns:
  * - none, but the row will be altered such that it solves as many problems singlehandedly as possible
  *  --> note that this does not mean that running this for the whole array will guarantee the smallest array;
- *      this is still a greedy algorithm for the current row, without any lookahead to future rows
+ *      this is still a greedy algorithm for the current row, without any lookahead to future rows (but see
+ *      beam_search())
 */
-void Array::heuristic_all(int *row)
+void Array::heuristic_all(int *row, uint64_t keep, std::vector<int*> *runners_up)
 {
-    // get scores for all relevant possible rows
-    std::map<int*, int64_t> scores;
-    heuristic_all_helper(row, 0, &scores);
-    //TODO: wait for all child processes to terminate (once threading has been implemented)
-
-    // inspect the scores for the best one(s)
-    int64_t best_score = INT64_MIN;
-    std::vector<int*> best_rows;    // there could be ties for the best
-    for (auto& kv : scores) {
-        if (kv.second >= best_score) {  // it was better or it tied
-            if (kv.second > best_score) {   // for an even better choice, can stop tracking the previous best
-                for (int *r : best_rows) delete[] r;
-                best_score = kv.second;
-                best_rows.clear();
-            }
-            best_rows.push_back(kv.first);  // whether it was better or only a tie, keep track of this row
-        } else delete[] kv.first;
+    prepare_bounds();
+
+    // make several subtrees per worker, so that a slow one doesn't hold up the rest; how many does not depend
+    // on the number of workers, since each subtree's share of the work and its first row depend on it
+    uint64_t split = 0, num_subtrees = 1;
+    while (split < num_factors && num_subtrees < 64)
+        num_subtrees *= factors[permutation[split++]]->level;
+
+    // per subtree, the columns above it are assigned first, with the bounds that follow from them
+    auto enter = [&](uint64_t subtree, Workspace *ws) {
+        std::copy(row, row + num_factors, ws->row.begin()); // the columns below the split start as in row
+        for (uint64_t depth = split; depth > 0; depth--) {  // subtree is a mixed-radix number, last column fastest
+            int c = permutation[depth-1];
+            uint64_t level = factors[c]->level;
+            ws->row[c] = static_cast<int>((static_cast<uint64_t>(row[c]) + subtree % level) % level);
+            subtree /= level;
+        }
+        ws->tuple_bounds = root_tuple_bounds;
+        ws->column_bounds = root_column_bounds;
+        uint64_t gain = 0;
+        for (uint64_t depth = 0; depth < split; depth++) {
+            gain += completed_gain(ws->row.data(), depth);
+            assign_bounds(ws->row.data(), depth, ws);
+        }
+        ws->trail.clear();  // nothing above the subtree gets undone
+        return gain;
+    };
+    uint64_t salt = rng();  // for breaking ties
+    for (Workspace &ws : workspaces) {
+        ws.selector.reset(keep, salt);
+        ws.row.resize(num_factors);
+        ws.branches.resize(num_factors*max_level);
+        ws.trail.clear();
     }
 
-    // choose the row that scored the best (for ties, choose randomly from among those tied for the best)
-    int choice = static_cast<uint64_t>(rand()) % best_rows.size(); // for breaking ties randomly
-    for (uint64_t col = 0; col < num_factors; col++)
-        row[col] = best_rows.at(choice)[col];
-    
-    // free memory
-    for (int *r : best_rows) delete[] r;
+    // first, follow only the most promising branches down to one row per subtree; the best keep of these rows
+    // (and the given row, which is a candidate too) set a bar for the whole search, known before it starts
+    std::vector<int64_t> probes(num_subtrees);
+    incumbent = std::numeric_limits<int64_t>::min();
+    pool->run(num_subtrees, [&](uint64_t subtree, uint64_t worker) {
+        Workspace *ws = &workspaces[worker];
+        ws->probing = true;
+        ws->cut = false;
+        heuristic_all_helper(row, split, enter(subtree, ws), ws);
+        probes[subtree] = ws->probe;
+    });
+    if (keep == 1) {
+        int64_t given = score_row(row, &workspaces[0]);
+        workspaces[0].selector.offer(given, row, num_factors);  // so that a search cut short never does worse
+        incumbent = std::max(given, *std::max_element(probes.begin(), probes.end()));
+    } else if (keep <= num_subtrees) {
+        std::nth_element(probes.begin(), probes.begin() + static_cast<int64_t>(keep - 1), probes.end(),
+            std::greater<int64_t>());
+        incumbent = probes[keep - 1];
+    }
+
+    // then search every subtree, each until it has done its share of the work, and get the best rows each
+    // worker sees; a subtree always gets as far as its first row, which was its probe unless that was pruned
+    pool->run(num_subtrees, [&](uint64_t subtree, uint64_t worker) {
+        Workspace *ws = &workspaces[worker];
+        ws->probing = false;
+        ws->cut = false;
+        ws->limit = ws->work + search_work/num_subtrees;
+        ws->found.reset(keep, salt);
+        heuristic_all_helper(row, split, enter(subtree, ws), ws);
+        ws->selector.merge(ws->found);
+    });
+
+    // choose the row that scored the best; ties were broken randomly, the same way whichever worker saw them
+    Selector &best = workspaces[0].selector;
+    for (uint64_t worker = 1; worker < workspaces.size(); worker++) best.merge(workspaces[worker].selector);
+    if (best.best().empty()) return;    // every row found fell short of the bar; keep the row
+    for (uint64_t place = 1; place < best.best().size(); place++) {
+        int *runner_up = new int[num_factors];
+        std::copy(best.best()[place].cells.begin(), best.best()[place].cells.end(), runner_up);
+        runners_up->push_back(runner_up);
+    }
+    std::copy(best.best()[0].cells.begin(), best.best()[0].cells.end(), row);
 }
 
 /* HELPER METHOD: heuristic_all_helper - performs top-down recursive logic for heuristic_all()
  * - heuristic_all() does the auxilary work to start the recursion, and handle the result
  * - this method uses recursion to form all possible combinations; its base case scores a given combination
+ * - the values of the column at each level are tried in order of how much they are worth to the tuples they
+ *   complete, so that good rows, and with them a high bar for pruning, are found early
+ * - when ws->probing is set, only the first value of each column is tried, and nothing is pruned or offered;
+ *   the score of the one row reached is left in ws->probe instead
  * 
  * parameters:
- * - row: integer array representing a row being considered for adding to the array
- * - cur_col: which column should have its levels looped over in the recursive case
- * --> overhead caller should pass 0 to this method initially
- * --> value should increment by 1 with each recursive call
+ * - row: integer array representing the row the candidates are offsets from; only read
+ * - depth: how many columns, in permutation order, have been assigned in the worker's candidate row
  * --> triggers the base case when value is equal to the total number of columns
- * - scores: pointer to a map whose keys are pointers to rows and whose values are the scores of those rows
- * --> overhead caller should pass the address of an empty map to this method initially
- * --> for each row inspected by the base case, a separate thread should handle the scoring and map updating
+ * - gain: total of gains (see prepare_bounds()) of the Interactions completed by the columns assigned so far
+ * - ws: scratch space belonging to the calling worker; the best candidates of its subtree are updated
  * 
  * returns:
- * - none, but scores will be modified to contain all the rows inspected and their scores
+ * - none, but ws->found will hold the best candidates it has been offered, unless ws->cut is set first
 */
-void Array::heuristic_all_helper(int *row, uint64_t cur_col, std::map<int*, int64_t> *scores)
+void Array::heuristic_all_helper(int *row, uint64_t depth, uint64_t gain, Workspace *ws)
 {
-    // base case: row represents a unique combination and is ready for scoring
-    if (cur_col == num_factors) {
+    // give up if even the most the columns left could add cannot catch the best so far, or at the budget
+    if (ws->cut) return;
+    if (!ws->probing) {
+        if (static_cast<int64_t>(gain + remaining_bound(depth, ws)) < std::max(incumbent, ws->found.threshold()))
+            return;
+        if (ws->work >= ws->limit && !ws->found.best().empty()) {
+            ws->cut = true;
+            return;
+        }
+    }
+    int *candidate = ws->row.data();
 
-        int *row_copy = new int[num_factors];   // must be deleted by heuristic_all() later
-        for (uint64_t col = 0; col < num_factors; col++) row_copy[col] = row[col];
-        heuristic_all_scorer(row_copy, scores);
+    // base case: row represents a unique combination and is ready for scoring
+    if (depth == num_factors) {
+        if (ws->probing) ws->probe = score_row(candidate, ws);
+        else ws->found.offer(score_row(candidate, ws), candidate, num_factors);
         return;
     }
 
     // recursive case: need to introduce another loop for the next factor
-    /*
-    if ((p == all && dont_cares[permutation[cur_col]] == all) ||
-        (p == c_and_l && dont_cares[permutation[cur_col]] == c_and_l) ||
-        (p == c_only && dont_cares[permutation[cur_col]] == c_only)) {
-        heuristic_all_helper(row, cur_col+1, scores);
-        return;
-    }//*/
-    for (uint64_t offset = 0; offset < factors[permutation[cur_col]]->level; offset++) {
-        int temp = row[permutation[cur_col]];
-        row[permutation[cur_col]] = (row[permutation[cur_col]] + static_cast<int>(offset)) %
-            static_cast<int>(factors[permutation[cur_col]]->level); // try every value for this factor
-        heuristic_all_helper(row, cur_col+1, scores);
-        row[permutation[cur_col]] = temp;
+    int col = permutation[depth];
+    uint64_t level = factors[col]->level;
+    std::pair<uint64_t, uint64_t> *branches = &ws->branches[depth*max_level];   // (gain, offset) per value
+    ws->work += level*(depth_starts[depth+1] - depth_starts[depth]) + num_factors - depth;
+    for (uint64_t offset = 0; offset < level; offset++) {
+        candidate[col] = static_cast<int>((static_cast<uint64_t>(row[col]) + offset) % level);
+        branches[offset] = {completed_gain(candidate, depth), offset};
+    }
+    std::sort(branches, branches + level, [](const std::pair<uint64_t, uint64_t> &a,
+        const std::pair<uint64_t, uint64_t> &b) { return a.first > b.first; });
+    for (uint64_t b = 0; b < level; b++) {
+        uint64_t offset = branches[b].second, mark = ws->trail.size();
+        candidate[col] = static_cast<int>((static_cast<uint64_t>(row[col]) + offset) % level);
+        assign_bounds(candidate, depth, ws);
+        heuristic_all_helper(row, depth+1, gain + branches[b].first, ws);
+        for (; ws->trail.size() > mark; ws->trail.pop_back()) *ws->trail.back().first = ws->trail.back().second;
+        if (ws->probing || ws->cut) break;  // the first branch is the most promising one
     }
 }
 
-/* HELPER METHOD: heuristic_all_scorer - scores a given row by testing what would change if it was added
- * - should be called in a unique thread
- * - heuristic_all() should await the termination of all sub threads before inspecting scores
+/* HELPER METHOD: prepare_bounds - works out the upper bounds heuristic_all() uses to prune candidate rows
+ * - score_row() adds up, over the Interactions and T sets occurring in a row, how many problems they would
+ *   solve; each of these is bounded on its own, regardless of the rest of the row:
+ *  --> an uncovered Interaction is worth exactly its weight
+ *  --> an undetectable Interaction gains separation from at most all of the T sets it is short of
+ *  --> a T set in a class of n that has occurred before stops conflicting with at most the other n-1 T sets,
+ *      and one that has never occurred before stops conflicting with at most every other T set
+ * - every T set occurring in a row does so through one of the row's Interactions, so charging each T set's
+ *   bound to all of its Interactions gives each Interaction a gain that bounds everything it brings along;
+ *   a row is then worth at most the sum of the gains of its Interactions, one per column tuple
+ * - each column tuple is completed at the depth of its last column in permutation order; until then, its
+ *   tuple bound holds, per value of that last column, the best gain of its Interactions that agree with the
+ *   columns assigned so far, and a column's bound holds the sum of these over the tuples it completes; the
+ *   most the unassigned columns can add is then the sum over them of their best value's column bound
+ * 
+ * returns:
+ * - void, but after the method finishes, the bounds before any column is assigned will be set
+*/
+void Array::prepare_bounds()
+{
+    std::vector<uint64_t> set_gains(sets.size(), 0);
+    if (p != c_only && !is_locating)
+        for (T *t_set : sets) {
+            if (t_set->is_locatable) continue;
+            if (t_set->rows.empty()) set_gains[t_set->rank] = 2*t_set->weight*sets.size();
+            else set_gains[t_set->rank] = 2*((location.class_size(t_set->rank) - 1)*t_set->weight +
+                location_weights[location.class_of[t_set->rank]] - t_set->weight);
+        }
+    gains.assign(interactions.size(), 0);
+    for (Interaction *i : interactions) {
+        if (!i->is_covered) gains[i->rank] += i->weight;
+        if (p == all && !i->is_detectable) gains[i->rank] += 3*i->weight*i->deficits;
+        for (T *t_set : i->sets) gains[i->rank] += set_gains[t_set->rank];
+    }
+    work += interactions.size() + (d + 1)*sets.size();  // each T set once on its own, then once per Interaction
+
+    // sort the column tuples by the depth at which they are completed
+    max_level = 1;
+    for (uint64_t col = 0; col < num_factors; col++)
+        if (factors[col]->level > max_level) max_level = factors[col]->level;
+    depth_of.resize(num_factors);
+    for (uint64_t depth = 0; depth < num_factors; depth++) depth_of[permutation[depth]] = depth;
+    tuple_depths.assign(num_tuples, 0);
+    tuple_lasts.assign(num_tuples, 0);
+    depth_starts.assign(num_factors + 1, 0);
+    for (uint64_t tuple = 0; tuple < num_tuples; tuple++) {
+        for (uint64_t j = 0; j < t; j++)
+            if (depth_of[tuple_columns[tuple*t + j]] >= tuple_depths[tuple]) {
+                tuple_depths[tuple] = depth_of[tuple_columns[tuple*t + j]];
+                tuple_lasts[tuple] = j;
+            }
+        depth_starts[tuple_depths[tuple] + 1]++;
+    }
+    for (uint64_t depth = 0; depth < num_factors; depth++) depth_starts[depth+1] += depth_starts[depth];
+    depth_tuples.resize(num_tuples);
+    std::vector<uint64_t> filled(depth_starts.begin(), depth_starts.end() - 1);
+    for (uint64_t tuple = 0; tuple < num_tuples; tuple++) depth_tuples[filled[tuple_depths[tuple]]++] = tuple;
+
+    // with nothing assigned, each tuple bound is the best gain over all Interactions with that last value
+    bound_offsets.resize(num_tuples);
+    root_tuple_bounds.clear();
+    root_column_bounds.assign(num_factors*max_level, 0);
+    for (uint64_t tuple = 0; tuple < num_tuples; tuple++) {
+        uint64_t j = tuple_lasts[tuple], col = tuple_columns[tuple*t + j];
+        bound_offsets[tuple] = root_tuple_bounds.size();
+        root_tuple_bounds.resize(root_tuple_bounds.size() + factors[col]->level, 0);
+        uint64_t *bounds = &root_tuple_bounds[bound_offsets[tuple]];
+        uint64_t last = tuple + 1 < num_tuples ? tuple_offsets[tuple+1] : interactions.size();
+        for (uint64_t rank = tuple_offsets[tuple]; rank < last; rank++) {
+            uint64_t value = interactions[rank]->singles[j]->value;
+            if (gains[rank] > bounds[value]) bounds[value] = gains[rank];
+        }
+        for (uint64_t value = 0; value < factors[col]->level; value++)
+            root_column_bounds[col*max_level + value] += bounds[value];
+    }
+}
+
+/* HELPER METHOD: assign_bounds - tightens a worker's bounds after a column is assigned in the search
+ * - every tuple containing the column that is not completed by it has its tuple bound recomputed over the
+ *   Interactions agreeing with all the columns assigned so far, and its last column's bound adjusted
+ * - every bound changed is saved on the worker's trail first, so that the caller can put it back
+ * 
+ * parameters:
+ * - row: the worker's candidate row, with the columns up to and including the given depth assigned
+ * - depth: the depth of the column just assigned
+ * - ws: scratch space belonging to the calling worker
+ * 
+ * returns:
+ * - void, but after the method finishes, ws will hold the bounds given the columns assigned
+*/
+void Array::assign_bounds(int *row, uint64_t depth, Workspace *ws)
+{
+    uint64_t col = static_cast<uint64_t>(permutation[depth]);
+    std::vector<uint64_t> &fresh = ws->fresh_bounds;    // kept all 0 between uses
+    if (fresh.size() < max_level) fresh.resize(max_level, 0);
+    for (uint64_t idx = column_starts[col]; idx < column_starts[col+1]; idx++) {
+        uint64_t tuple = column_tuples[idx];
+        if (tuple_depths[tuple] <= depth) continue; // completed by now, so its gain is known exactly
+        uint64_t j = tuple_lasts[tuple], last_col = tuple_columns[tuple*t + j], level = factors[last_col]->level;
+        uint64_t last = tuple + 1 < num_tuples ? tuple_offsets[tuple+1] : interactions.size();
+        ws->work += last - tuple_offsets[tuple];
+        for (uint64_t rank = tuple_offsets[tuple]; rank < last; rank++) {
+            bool agrees = true;
+            for (Single *s : interactions[rank]->singles)
+                if (depth_of[s->factor] <= depth && static_cast<int>(s->value) != row[s->factor]) {
+                    agrees = false;
+                    break;
+                }
+            if (agrees && gains[rank] > fresh[interactions[rank]->singles[j]->value])
+                fresh[interactions[rank]->singles[j]->value] = gains[rank];
+        }
+        uint64_t *bounds = &ws->tuple_bounds[bound_offsets[tuple]];
+        uint64_t *column = &ws->column_bounds[last_col*max_level];
+        for (uint64_t value = 0; value < level; value++) {
+            if (fresh[value] != bounds[value]) {    // bounds only ever shrink as more columns are assigned
+                ws->trail.emplace_back(&bounds[value], bounds[value]);
+                ws->trail.emplace_back(&column[value], column[value]);
+                column[value] -= bounds[value] - fresh[value];
+                bounds[value] = fresh[value];
+            }
+            fresh[value] = 0;
+        }
+    }
+}
+
+/* HELPER METHOD: remaining_bound - bounds what the columns from a given depth onwards can add to a row
+ * 
+ * parameters:
+ * - depth: the depth of the first column not yet assigned
+ * - ws: scratch space belonging to the calling worker, holding the bounds given the columns assigned
+ * 
+ * returns:
+ * - the sum, over the columns not yet assigned, of the largest of each one's column bounds
+*/
+uint64_t Array::remaining_bound(uint64_t depth, Workspace *ws)
+{
+    uint64_t bound = 0;
+    for (; depth < num_factors; depth++) {
+        uint64_t col = static_cast<uint64_t>(permutation[depth]);
+        const uint64_t *column = &ws->column_bounds[col*max_level];
+        bound += *std::max_element(column, column + factors[col]->level);
+    }
+    return bound;
+}
+
+/* HELPER METHOD: completed_gain - totals the gains of the Interactions completed at a given depth
  * 
  * parameters:
- * - row_v: a vector representing the row to be scored
- *  --> cannot be a pointer to the row being modified by heuristic_all_helper() (would result in data races)
- * - scores: pointer to 
+ * - row: integer array representing a row whose columns are assigned at least up to the given depth
+ * - depth: the depth of interest, i.e., the position in permutation order of the last column assigned
  * 
  * returns:
- * - none, but best_rows will be modified to contain whichever row(s) scored best
- * --> also, best_score will be modified, but this value will likely not be needed by the caller
+ * - the sum of gains (see prepare_bounds()) of the row's Interactions in the tuples completed at that depth
 */
-void Array::heuristic_all_scorer(int *row, std::map<int*, int64_t> *scores)
+uint64_t Array::completed_gain(int *row, uint64_t depth)
 {
-    // current thread will work with unique copies of the data structures being modified
-    Array *copy = clone();
-    copy->update_array(row, false); // see how all scores, etc., would change
-
-    // define the row score to be the combination of net changes below, weighted by importance
-    int64_t row_score = 0; //= prev_score - static_cast<int64_t>(score);
-    for (Single *this_s : singles) { // improve the score based on individual Single improvement
-        Single *copy_s = copy->single_map.at(this_s->to_string());
-        uint64_t weight = (factors[this_s->factor]->level); // higher level factors hold more weight
-        row_score += static_cast<int64_t>(weight*(this_s->c_issues - copy_s->c_issues));
-        row_score += 2*weight*(this_s->l_issues - copy_s->l_issues);
-        row_score += static_cast<int64_t>(3*weight*(this_s->d_issues - copy_s->d_issues));
-    }
-
-    // need to add result to data structure containing all thread's results; use mutex for thread safety
-    scores_mutex.lock();
-    scores->insert({row, row_score});
-    scores_mutex.unlock();
-
-    delete copy;
-    // note: do not delete row here, as heuristic_all() will need to reference it
-}
\ No newline at end of file
+    uint64_t gain = 0;
+    for (uint64_t idx = depth_starts[depth]; idx < depth_starts[depth+1]; idx++)
+        gain += gains[interaction_rank(row, depth_tuples[idx])];
+    return gain;
+}
+
+/* HELPER METHOD: score_row - scores a row by working out what would change if it was added, without adding it
+ * - only reads the state of the Array, so it is safe for several workers to call at once, each with its own
+ *   Workspace; the work done is proportional to the Interactions and T sets occurring in the row
+ * - the score is the net improvement in coverage, location, and detection issues over all Singles, weighted
+ *   by importance: higher level factors hold more weight, and location and detection issues are worth 2 and
+ *   3 times as much as coverage issues; this is exactly what adding the row and comparing would show
+ * 
+ * parameters:
+ * - row: integer array representing the row to be scored
+ * - ws: scratch space belonging to the calling thread
+ * 
+ * returns:
+ * - the score of the row; higher is better
+*/
+int64_t Array::score_row(int *row, Workspace *ws)
+{
+    uint64_t row_score = 0;
+    build_row_interactions(row, &ws->row_interactions);
+
+    // coverage: every uncovered Interaction in the row would become covered
+    for (Interaction *i : ws->row_interactions)
+        if (!i->is_covered) row_score += i->weight;
+    ws->work += num_tuples;
+    if (p == c_only) return static_cast<int64_t>(row_score);
+
+    ws->row_sets.clear();   // all T sets that would occur in this row
+    for (Interaction *i : ws->row_interactions) {
+        for (T *t_set : i->sets) {
+            if (ws->row_set_ranks.test(t_set->rank)) continue;
+            ws->row_set_ranks.set(t_set->rank);
+            ws->row_sets.push_back(t_set);
+        }
+        ws->work += i->sets.size();
+    }
+
+    // detection: an undetectable Interaction would gain separation from every T set not in this row
+    if (p == all)
+        for (Interaction *i : ws->row_interactions) {
+            if (i->is_detectable) continue;
+            ws->work += ws->row_sets.size();
+            uint64_t gained = i->deficits;  // T sets it is not yet separated enough from...
+            for (T *t_set : ws->row_sets)   // ...minus those in this row (sets containing it are never counted)
+                if (separation.get(i->rank, t_set->rank) < delta) gained--;
+            row_score += 3*i->weight*gained;
+        }
+
+    // location: each class of T sets with identical rows would split into those in this row and the rest
+    if (!is_locating) {
+        if (ws->class_counts.size() < location.num_classes()) {
+            ws->class_counts.resize(location.num_classes(), 0);
+            ws->class_weights.resize(location.num_classes(), 0);
+        }
+        for (T *t_set : ws->row_sets) {
+            if (t_set->is_locatable) continue;
+            uint64_t c = location.class_of[t_set->rank];
+            if (ws->class_counts[c]++ == 0) ws->touched.push_back(c);
+            ws->class_weights[c] += t_set->weight;
+        }
+        ws->work += ws->row_sets.size() + ws->touched.size();
+        for (uint64_t c : ws->touched) {
+            uint64_t in_row = ws->class_counts[c], not_in_row = location.size_of(c) - in_row;
+            if (sets[location.elements[location.starts[c]]]->rows.empty())  // occurring for the first time
+                row_score += 2*ws->class_weights[c]*(sets.size() - (in_row - 1));
+            else    // every pair of one T set from each side stops conflicting
+                row_score += 2*(ws->class_weights[c]*not_in_row +
+                    (location_weights[c] - ws->class_weights[c])*in_row);
+            ws->class_counts[c] = 0;
+            ws->class_weights[c] = 0;
+        }
+        ws->touched.clear();
+    }
+
+    for (T *t_set : ws->row_sets) ws->row_set_ranks.reset(t_set->rank);
+    ws->work += ws->row_sets.size();
+    return static_cast<int64_t>(row_score);
+}
@@ -0,0 +1,213 @@
+/* Array-Generator by Isaac Jung
+Last updated 10/16/2026
+
+|===========================================================================================================|
+|   This file contains definitions for methods belonging to the Ipog class declared in ipog.h. See that     |
+| header for a description of how columns are added.                                                        |
+|===========================================================================================================|
+*/
+
+#include "ipog.h"
+
+// defined here as well, since std::vector takes it by reference
+const int Ipog::DONT_CARE;
+
+/* CONSTRUCTOR - initializes the object
+ * - overloaded: this is the default with no parameters, and should not be used
+*/
+Ipog::Ipog()
+{
+    t = 0;
+}
+
+/* CONSTRUCTOR - initializes the object
+ * - overloaded: this version can set its fields based on the levels of the columns
+*/
+Ipog::Ipog(const std::vector<uint64_t> &levels_o, uint64_t t_o)
+{
+    levels = levels_o;
+    t = t_o;
+}
+
+/* SUB METHOD: build - builds a covering array of strength t, one column at a time
+ * - the first t columns get every combination of their values, with the last column varying fastest
+ * 
+ * returns:
+ * - void, but after the method finishes, rows will cover every t-way interaction, with don't cares left in
+*/
+void Ipog::build()
+{
+    uint64_t first = t < levels.size() ? t : levels.size(), count = 1;
+    for (uint64_t col = 0; col < first; col++) count *= levels[col];
+    for (uint64_t idx = 0; idx < count; idx++) {
+        std::vector<int> row(levels.size(), DONT_CARE);
+        uint64_t rest = idx;
+        for (uint64_t col = first; col > 0; col--) {
+            row[col-1] = static_cast<int>(rest % levels[col-1]);
+            rest /= levels[col-1];
+        }
+        rows.push_back(row);
+    }
+    for (uint64_t col = first; col < levels.size(); col++) {
+        open_column(col);
+        grow_horizontally(col);
+        grow_vertically(col);
+    }
+}
+
+/* HELPER METHOD: open_column - lists the sets of t-1 earlier columns and marks every interaction uncovered
+ * 
+ * parameters:
+ * - col: the column about to be added; must be at least t-1
+ * 
+ * returns:
+ * - void, but after the method finishes, subsets, offsets, and uncovered will be ready for the column
+*/
+void Ipog::open_column(uint64_t col)
+{
+    subsets.clear();
+    offsets.assign(1, 0);
+    std::vector<uint64_t> pick(t - 1);
+    for (uint64_t j = 0; j < t - 1; j++) pick[j] = j;
+    while (true) {
+        uint64_t size = levels[col];
+        for (uint64_t c : pick) {
+            subsets.push_back(c);
+            size *= levels[c];
+        }
+        offsets.push_back(offsets.back() + size);
+
+        // advance to the next set in lexicographic order, if there is one
+        uint64_t j = t - 1;
+        while (j > 0 && pick[j-1] == col - t + j) j--;
+        if (j == 0) break;
+        pick[j-1]++;
+        for (; j < t - 1; j++) pick[j] = pick[j-1] + 1;
+    }
+    uncovered.assign((offsets.back() + 63)/64, ~uint64_t{0});
+}
+
+/* HELPER METHOD: grow_horizontally - gives every row so far a value for the new column
+ * - each row gets the value covering the most uncovered interactions, the lowest one in a tie, or keeps a
+ *   don't care if no value covers any
+ * 
+ * parameters:
+ * - col: the column being added
+ * 
+ * returns:
+ * - void, but after the method finishes, the interactions covered by the rows will be marked covered
+*/
+void Ipog::grow_horizontally(uint64_t col)
+{
+    uint64_t num_subsets = offsets.size() - 1;
+    for (std::vector<int> &row : rows) {
+        counts.assign(levels[col], 0);
+        for (uint64_t subset = 0; subset < num_subsets; subset++) {
+            uint64_t start = block(row, subset, col);
+            if (start == UINT64_MAX) continue;
+            for (uint64_t value = 0; value < levels[col]; value++) if (test(start + value)) counts[value]++;
+        }
+        uint64_t best = 0;
+        for (uint64_t value = 1; value < levels[col]; value++) if (counts[value] > counts[best]) best = value;
+        if (counts[best] == 0) continue;
+        row[col] = static_cast<int>(best);
+        cover(row, col);
+    }
+}
+
+/* HELPER METHOD: grow_vertically - makes room in the rows for every interaction the new column left uncovered
+ * - each one goes into the first row with a don't care among the first col+1 columns whose cells for it
+ *   are don't cares or agree with it already, or else a new row of don't cares
+ * 
+ * parameters:
+ * - col: the column being added
+ * 
+ * returns:
+ * - void, but after the method finishes, every interaction of the new column will be covered
+*/
+void Ipog::grow_vertically(uint64_t col)
+{
+    std::vector<uint64_t> open;     // rows that can still take an interaction
+    for (uint64_t r = 0; r < rows.size(); r++)
+        for (uint64_t c = 0; c <= col; c++)
+            if (rows[r][c] == DONT_CARE) {
+                open.push_back(r);
+                break;
+            }
+
+    uint64_t num_subsets = offsets.size() - 1;
+    std::vector<int> values(t);     // the values of the interaction being placed, in the order of its columns
+    for (uint64_t subset = 0; subset < num_subsets; subset++) {
+        const uint64_t *columns = subsets.data() + subset*(t - 1);  // no columns at all if t is 1
+        for (uint64_t bit = offsets[subset]; bit < offsets[subset+1]; bit++) {
+            if (!test(bit)) continue;
+            uint64_t rest = bit - offsets[subset];
+            values[t-1] = static_cast<int>(rest % levels[col]);
+            rest /= levels[col];
+            for (uint64_t j = t - 1; j > 0; j--) {
+                values[j-1] = static_cast<int>(rest % levels[columns[j-1]]);
+                rest /= levels[columns[j-1]];
+            }
+
+            uint64_t found = rows.size();
+            for (uint64_t r : open) {
+                bool fits = rows[r][col] == DONT_CARE || rows[r][col] == values[t-1];
+                for (uint64_t j = 0; j < t - 1 && fits; j++)
+                    fits = rows[r][columns[j]] == DONT_CARE || rows[r][columns[j]] == values[j];
+                if (fits) {
+                    found = r;
+                    break;
+                }
+            }
+            if (found == rows.size()) {
+                rows.push_back(std::vector<int>(levels.size(), DONT_CARE));
+                open.push_back(found);
+            }
+            std::vector<int> &row = rows[found];
+            row[col] = values[t-1];
+            for (uint64_t j = 0; j < t - 1; j++) row[columns[j]] = values[j];
+            cover(row, col);    // it may now cover others besides this one
+        }
+    }
+}
+
+/* UTILITY METHOD: block - finds where a row's block of bits for a set of earlier columns starts
+ * 
+ * parameters:
+ * - row: the row in question
+ * - subset: index of the set of t-1 earlier columns
+ * - col: the column being added
+ * 
+ * returns:
+ * - the position in uncovered of the bit for the row's values in the set and the new column at value 0, or
+ *   UINT64_MAX if the row has a don't care in the set
+*/
+uint64_t Ipog::block(const std::vector<int> &row, uint64_t subset, uint64_t col)
+{
+    uint64_t idx = 0;
+    for (uint64_t j = 0; j < t - 1; j++) {
+        uint64_t c = subsets[subset*(t - 1) + j];
+        if (row[c] == DONT_CARE) return UINT64_MAX;
+        idx = idx*levels[c] + static_cast<uint64_t>(row[c]);
+    }
+    return offsets[subset] + idx*levels[col];
+}
+
+/* HELPER METHOD: cover - marks every interaction of the new column that a row has as covered
+ * 
+ * parameters:
+ * - row: the row in question
+ * - col: the column being added
+ * 
+ * returns:
+ * - void, but after the method finishes, the bits for the row's interactions will be cleared
+*/
+void Ipog::cover(const std::vector<int> &row, uint64_t col)
+{
+    if (row[col] == DONT_CARE) return;
+    uint64_t num_subsets = offsets.size() - 1;
+    for (uint64_t subset = 0; subset < num_subsets; subset++) {
+        uint64_t start = block(row, subset, col);
+        if (start != UINT64_MAX) clear(start + static_cast<uint64_t>(row[col]));
+    }
+}
@@ -0,0 +1,40 @@
+/* Array-Generator by Isaac Jung
+Last updated 10/16/2026
+
+|===========================================================================================================|
+|   This file contains definitions for methods belonging to the Journal class declared in journal.h. See    |
+| that header for a description of how changes are recorded.                                                |
+|===========================================================================================================|
+*/
+
+#include "journal.h"
+
+/* CONSTRUCTOR - initializes the object
+*/
+Journal::Journal()
+{
+    recording = false;
+}
+
+/* SUB METHOD: restore - undoes everything saved since the journal was last restored
+ * - values are written back newest first, so a field saved several times ends up with its oldest value
+ * - splits are merged newest first, as required by Partition::merge(), and then marks are undone newest first,
+ *   as required by Partition::unmark(), so the partition's members are back in their old order too
+ *
+ * parameters:
+ * - partition: the partition the recorded splits were made in
+ *
+ * returns:
+ * - void, but after the method finishes, every saved field will hold its old value and the journal is empty
+*/
+void Journal::restore(Partition *partition)
+{
+    for (uint64_t idx = counters.size(); idx > 0; idx--) *counters[idx-1].first = counters[idx-1].second;
+    for (uint64_t idx = flags.size(); idx > 0; idx--) *flags[idx-1].first = flags[idx-1].second;
+    for (uint64_t idx = splits.size(); idx > 0; idx--) partition->merge(splits[idx-1]);
+    for (uint64_t idx = marks.size(); idx > 0; idx--) partition->unmark(marks[idx-1].first, marks[idx-1].second);
+    counters.clear();
+    flags.clear();
+    splits.clear();
+    marks.clear();
+}
@@ -0,0 +1,123 @@
+/* Array-Generator by Isaac Jung
+Last updated 10/16/2026
+
+|===========================================================================================================|
+|   This file contains definitions for methods belonging to the Orthogonal class declared in orthogonal.h.  |
+| See that header for a description of how the rows and the field behind them are built.                    |
+|===========================================================================================================|
+*/
+
+#include "orthogonal.h"
+
+/* CONSTRUCTOR - initializes the object
+ * - overloaded: this is the default with no parameters, and should not be used
+*/
+Orthogonal::Orthogonal()
+{
+    q = 0; p = 0; m = 0;
+}
+
+/* CONSTRUCTOR - initializes the object
+ * - overloaded: this version can set its fields based on the number of levels
+*/
+Orthogonal::Orthogonal(uint64_t q_o)
+{
+    q = q_o;
+    for (p = 2; q % p != 0; p++) {}    // the smallest factor of a prime power is its prime
+    m = 0;
+    for (uint64_t rest = q; rest > 1; rest /= p) m++;
+}
+
+/* SUB METHOD: build - builds an orthogonal array of strength 2 with q*q rows and q+1 columns
+ * 
+ * returns:
+ * - void, but after the method finishes, rows will have every pair of values of every two columns once
+*/
+void Orthogonal::build()
+{
+    build_tables();
+    for (uint64_t a = 0; a < q; a++) {
+        for (uint64_t b = 0; b < q; b++) {
+            std::vector<int> row(q + 1);
+            for (uint64_t x = 0; x < q; x++) row[x] = static_cast<int>(sums[products[a*q + x]*q + b]);
+            row[q] = static_cast<int>(a);
+            rows.push_back(row);
+        }
+    }
+}
+
+/* UTILITY METHOD: is_prime_power - checks whether a number is a power of a prime
+ * 
+ * parameters:
+ * - n: the number to check
+ * 
+ * returns:
+ * - true if n is p^m for some prime p and m of at least 1, false otherwise
+*/
+bool Orthogonal::is_prime_power(uint64_t n)
+{
+    if (n < 2) return false;
+    uint64_t factor = 2;
+    while (n % factor != 0) factor++;
+    while (n % factor == 0) n /= factor;
+    return n == 1;
+}
+
+/* HELPER METHOD: build_tables - works out the sum and product of every pair of elements of GF(q)
+ * - every monic polynomial of degree m is tried as the modulus, in order, until one has no factors
+ * 
+ * returns:
+ * - void, but after the method finishes, sums and products will be filled in
+*/
+void Orthogonal::build_tables()
+{
+    sums.resize(q*q);
+    for (uint64_t x = 0; x < q; x++) {
+        for (uint64_t y = 0; y < q; y++) {
+            uint64_t sum = 0;
+            for (uint64_t place = 1, rx = x, ry = y; place < q; place *= p, rx /= p, ry /= p)
+                sum += (rx % p + ry % p) % p*place;
+            sums[x*q + y] = sum;
+        }
+    }
+    std::vector<uint64_t> modulus(m, 0);    // the coefficients below x^m
+    for (uint64_t idx = 0; idx < q; idx++) {
+        for (uint64_t i = 0, rest = idx; i < m; i++, rest /= p) modulus[i] = rest % p;
+        if (try_modulus(modulus)) return;
+    }
+}
+
+/* HELPER METHOD: try_modulus - works out the product of every pair of elements, taking remainders by x^m plus
+ *   the given polynomial
+ * 
+ * parameters:
+ * - modulus: the coefficients of the terms below x^m, lowest first
+ * 
+ * returns:
+ * - true if the polynomial has no factors, in which case products holds the products of GF(q); false if two
+ *   nonzero elements had a product of 0, which shows that it does
+*/
+bool Orthogonal::try_modulus(const std::vector<uint64_t> &modulus)
+{
+    products.resize(q*q);
+    std::vector<uint64_t> xd(m), yd(m), product(2*m - 1);
+    for (uint64_t x = 0; x < q; x++) {
+        for (uint64_t i = 0, rest = x; i < m; i++, rest /= p) xd[i] = rest % p;
+        for (uint64_t y = 0; y < q; y++) {
+            for (uint64_t i = 0, rest = y; i < m; i++, rest /= p) yd[i] = rest % p;
+            product.assign(2*m - 1, 0);
+            for (uint64_t i = 0; i < m; i++)
+                for (uint64_t j = 0; j < m; j++) product[i + j] = (product[i + j] + xd[i]*yd[j]) % p;
+            for (uint64_t k = 2*m - 2; k >= m; k--) {   // x^m is the same as minus the modulus's lower terms
+                for (uint64_t i = 0; i < m; i++)
+                    product[k - m + i] = (product[k - m + i] + (p - modulus[i])*product[k]) % p;
+                product[k] = 0;
+            }
+            uint64_t value = 0;
+            for (uint64_t i = m; i > 0; i--) value = value*p + product[i-1];
+            if (value == 0 && x != 0 && y != 0) return false;
+            products[x*q + y] = value;
+        }
+    }
+    return true;
+}
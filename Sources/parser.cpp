@@ -1,5 +1,5 @@
 /* Array-Generator by Isaac Jung
-Last updated 09/20/2022
+Last updated 10/16/2026
 
 |===========================================================================================================|
 |   This file contains definitions for methods used to process input via an Parser class. Should the input  |
@@ -11,6 +11,8 @@ Last updated 09/20/2022
 #include <sstream>
 #include <iostream>
 #include <algorithm>
+#include <cctype>
+#include <ctime>
 
 // method forward declarations
 bool bad_t(uint64_t t, uint64_t num_cols);
@@ -24,6 +26,9 @@ Parser::Parser()
 {
     d = 1; t = 2; delta = 1;
     debug = d_off; v = v_off; o = normal; p = all;
+    threads = 0; beam = 1; depth = 1; engine = greedy; prune = prune_off; anneal = 0;
+    search_work = 2000; row_price = 6000; portfolio = 1; seed = static_cast<uint64_t>(time(nullptr));
+    checkpoint = ""; checkpoint_rows = 0; checkpoint_seconds = 0; resume = "";
     in_filename = ""; out_filename = "";
 }
 
@@ -36,7 +41,68 @@ Parser::Parser(int argc, char *argv[]) : Parser()
     p = c_only;
     while (itr < argc) {
         std::string arg(argv[itr]);    // cast to std::string
-        if (arg.at(0) == '-') { // flags
+        if (arg.compare(0, 2, "--") == 0) { // options, given as --name value or --name=value
+            std::string name = arg.substr(2), value = "";
+            uint64_t eq = name.find('=');
+            if (eq != std::string::npos) {
+                value = name.substr(eq + 1);
+                name = name.substr(0, eq);
+            }
+            if (name == "threads" || name == "beam" || name == "depth" || name == "anneal" ||
+                name == "search-work" || name == "row-price" || name == "portfolio" || name == "checkpoint-rows" ||
+                name == "checkpoint-seconds") { // positive ints
+                if (eq == std::string::npos && itr + 1 < argc) value = argv[++itr];
+                try {
+                    int param = std::stoi(value);
+                    if (param < 1) throw 0;
+                    if (name == "threads") threads = static_cast<uint64_t>(param);
+                    else if (name == "beam") beam = static_cast<uint64_t>(param);
+                    else if (name == "depth") depth = static_cast<uint64_t>(param);
+                    else if (name == "anneal") anneal = static_cast<uint64_t>(param);
+                    else if (name == "search-work") search_work = static_cast<uint64_t>(param);
+                    else if (name == "row-price") row_price = static_cast<uint64_t>(param);
+                    else if (name == "portfolio") portfolio = static_cast<uint64_t>(param);
+                    else if (name == "checkpoint-rows") checkpoint_rows = static_cast<uint64_t>(param);
+                    else checkpoint_seconds = static_cast<uint64_t>(param);
+                } catch ( ... ) {
+                    printf("NOTE: bad value <%s> for option --%s; ignored", value.c_str(), name.c_str());
+                    printf(" (expected a positive int)\n");
+                }
+            } else if (name == "seed") {
+                if (eq == std::string::npos && itr + 1 < argc) value = argv[++itr];
+                try {
+                    if (value.empty() || !isdigit(value.at(0))) throw 0;    // stoull would wrap negatives
+                    seed = static_cast<uint64_t>(std::stoull(value));
+                } catch ( ... ) {
+                    printf("NOTE: bad value <%s> for option --seed; ignored", value.c_str());
+                    printf(" (expected a non-negative int)\n");
+                }
+            } else if (name == "checkpoint" || name == "resume") {  // paths
+                if (eq == std::string::npos && itr + 1 < argc) value = argv[++itr];
+                if (value.empty()) printf("NOTE: no path given for option --%s; ignored\n", name.c_str());
+                else if (name == "checkpoint") checkpoint = value;
+                else resume = value;
+            } else if (name == "engine") {
+                if (eq == std::string::npos && itr + 1 < argc) value = argv[++itr];
+                if (value == "greedy") engine = greedy;
+                else if (value == "density") engine = density;
+                else if (value == "ipog") engine = ipog;
+                else {
+                    printf("NOTE: bad value <%s> for option --engine; ignored", value.c_str());
+                    printf(" (expected greedy, density, or ipog)\n");
+                }
+            } else if (name == "prune") {
+                if (eq == std::string::npos && itr + 1 < argc) value = argv[++itr];
+                if (value == "off") prune = prune_off;
+                else if (value == "oldest") prune = prune_oldest;
+                else if (value == "newest") prune = prune_newest;
+                else if (value == "random") prune = prune_random;
+                else {
+                    printf("NOTE: bad value <%s> for option --prune; ignored", value.c_str());
+                    printf(" (expected off, oldest, newest, or random)\n");
+                }
+            } else printf("NOTE: bad option <%s>; ignored\n", arg.c_str());
+        } else if (arg.at(0) == '-') { // flags
             for (char c : arg.substr(1, arg.length() - 1)) {
                 switch(c) {
                     case 'd':
@@ -89,6 +155,16 @@ Parser::Parser(int argc, char *argv[]) : Parser()
         }
         itr++;
     }
+    if (engine == ipog && p != c_only) {
+        printf("NOTE: engine ipog only builds covering arrays; using greedy\n");
+        engine = greedy;
+    }
+    if (portfolio > 1 && (!checkpoint.empty() || !resume.empty())) {
+        printf("NOTE: checkpoints are not supported with option --portfolio; ignored\n");
+        checkpoint = "";
+        resume = "";
+    }
+    if (!checkpoint.empty() && checkpoint_rows == 0 && checkpoint_seconds == 0) checkpoint_seconds = 600;
 }
 
 /* SUB METHOD: process_input - reads from standard in to initialize program data
@@ -141,7 +217,52 @@ int Parser::process_input()
         return -1;
     }
 
+    // R, only if the line starts with the word rows; otherwise, the rest of the file is notes
+    if (std::getline(in, cur_line)) {
+        std::istringstream iss(cur_line);
+        std::string word, extra;
+        if ((iss >> word) && word == "rows") {
+            try {
+                if (!(iss >> num_rows)) throw 0;    // error when R not given or not int
+                if (iss >> extra) throw 0;          // error when anything follows it
+            } catch (...) {
+                syntax_error(3, "rows R", cur_line);
+                in.close();
+                return -1;
+            }
+        }
+    }
+
+    // rows
+    for (uint64_t r = 0; r < num_rows; r++) {
+        int lineno = static_cast<int>(r) + 4;
+        if (!std::getline(in, cur_line)) cur_line = "";
+        uint64_t *row = new uint64_t[num_cols];
+        array.push_back(row);
+        try {
+            std::istringstream iss(cur_line);
+            for (uint64_t col = 0; col < num_cols; col++)
+                if (!(iss >> row[col])) throw 0;    // error when not enough values given or not int
+        } catch (...) {
+            syntax_error(lineno, "V_1 V_2 ... V_C", cur_line);
+            in.close();
+            return -1;
+        }
+        for (uint64_t col = 0; col < num_cols; col++) {
+            if (row[col] >= levels[col]) {  // error when a value is not one of its factor's levels
+                semantic_error(lineno, static_cast<int>(r) + 1, static_cast<int>(col) + 1,
+                    static_cast<int>(levels[col]), static_cast<int>(row[col]));
+                in.close();
+                return -1;
+            }
+        }
+    }
+
     in.close();
+    if ((num_rows > 0 || !resume.empty()) && engine == ipog) {
+        printf("NOTE: engine ipog cannot extend existing rows; using greedy\n");
+        engine = greedy;
+    }
     if (bad_t(t, num_cols)) return -1;
     if (bad_d(d, t, &levels, p)) return -1;
     if (bad_delta(d, t, delta)) return -1;
@@ -189,6 +310,28 @@ void Parser::syntax_error(int lineno, std::string expected, std::string actual,
     printf("\n");
 }
 
+/* HELPER METHOD: semantic_error - prints an error message regarding a value out of its factor's range
+ * 
+ * parameters:
+ * - lineno: line number on which the value was given
+ * - row: row of the array the value was given for, counting from 1
+ * - col: column of the array the value was given for, counting from 1
+ * - level: number of levels of the column's factor
+ * - value: the value given
+ * - verbose: whether to print extra error output (true by default)
+ * 
+ * returns:
+ * - void (caller should decide whether to quit or continue)
+*/
+void Parser::semantic_error(int lineno, int row, int col, int level, int value, bool verbose)
+{
+    printf("\t-- ERROR --\n\tInvalid value on line %d. Row %d, column %d was given %d, but its factor only has ",
+        lineno, row, col, value);
+    printf("%d levels (0 to %d).\n", level, level - 1);
+    if (verbose) printf("\tFor formatting details, please check the README.\n");
+    printf("\n");
+}
+
 /* DECONSTRUCTOR - frees memory
 */
 Parser::~Parser()
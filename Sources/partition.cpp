@@ -0,0 +1,135 @@
+/* Array-Generator by Isaac Jung
+Last updated 10/16/2026
+
+|===========================================================================================================|
+|   This file contains definitions for methods belonging to the Partition class declared in partition.h.   |
+| See that header for a description of the refinement scheme.                                               |
+|===========================================================================================================|
+*/
+
+#include "partition.h"
+
+/* CONSTRUCTOR - initializes the object
+ * - overloaded: this is the default with no parameters; it holds no members and no classes
+*/
+Partition::Partition()
+{
+}
+
+/* CONSTRUCTOR - initializes the object
+ * - overloaded: this version puts the members 0 to n-1 into a single class with id 0
+*/
+Partition::Partition(uint64_t n) : Partition::Partition()
+{
+    elements.resize(n);
+    position.resize(n);
+    class_of.assign(n, 0);
+    for (uint64_t i = 0; i < n; i++) {
+        elements[i] = i;
+        position[i] = i;
+    }
+    starts.push_back(0);
+    ends.push_back(n);
+    marks.push_back(0);
+}
+
+/* SUB METHOD: mark - marks a member so that the next call to refine() separates it from unmarked members
+ * - the member is swapped to the front of its class, behind any members of that class already marked
+ * - a member must not be marked twice before the next refine()
+ *
+ * parameters:
+ * - member: the member to mark
+ *
+ * returns:
+ * - the index in elements the member was moved from, which unmark() needs to move it back
+*/
+uint64_t Partition::mark(uint64_t member)
+{
+    uint64_t c = class_of[member];
+    uint64_t target = starts[c] + marks[c];
+    uint64_t from = position[member];
+    uint64_t other = elements[target];
+    elements[target] = member;
+    elements[from] = other;
+    position[other] = from;
+    position[member] = target;
+    if (marks[c]++ == 0) touched.push_back(c);
+    return from;
+}
+
+/* SUB METHOD: refine - splits every class that has marked members into its marked and unmarked members
+ * - the unmarked members keep the class id; the marked members get a new one, unless all were marked
+ * - all marks are cleared afterwards
+ *
+ * parameters:
+ * - splits: list to which one Split is appended per class that had marked members
+ *
+ * returns:
+ * - void, but after the method finishes, the partition will have been refined
+*/
+void Partition::refine(std::vector<Split> *splits)
+{
+    for (uint64_t c : touched) {
+        Split split;
+        split.num_marked = marks[c];
+        split.size = size_of(c);
+        marks[c] = 0;
+        if (split.num_marked == split.size) {   // nothing to separate the marked members from
+            split.marked = c;
+            split.unmarked = Split::NO_CLASS;
+        } else {
+            split.marked = starts.size();
+            split.unmarked = c;
+            starts.push_back(starts[c]);
+            ends.push_back(starts[c] + split.num_marked);
+            marks.push_back(0);
+            starts[c] += split.num_marked;
+            for (uint64_t i = starts[split.marked]; i < ends[split.marked]; i++)
+                class_of[elements[i]] = split.marked;
+        }
+        splits->push_back(split);
+    }
+    touched.clear();
+}
+
+/* SUB METHOD: merge - undoes a split made by refine()
+ * - splits must be undone in the reverse of the order they were made in, so that the class being removed
+ *   is always the newest one
+ *
+ * parameters:
+ * - split: the Split to undo, as reported by refine()
+ *
+ * returns:
+ * - void, but after the method finishes, the marked members will be back in their original class
+*/
+void Partition::merge(const Split &split)
+{
+    if (split.unmarked == Split::NO_CLASS) return;  // the class was never actually split
+    for (uint64_t i = starts[split.marked]; i < ends[split.marked]; i++) class_of[elements[i]] = split.unmarked;
+    starts[split.unmarked] = starts[split.marked];
+    starts.pop_back();
+    ends.pop_back();
+    marks.pop_back();
+}
+
+/* SUB METHOD: unmark - undoes the move mark() made, once the split of the member's class has been merged
+ * - marks must be undone in the reverse of the order they were made in, after every split made since them
+ *   has been merged; merge() only changes which class members belong to, and marking only moves members
+ *   within their class, so merging first and then unmarking puts every member back at its old index
+ *
+ * parameters:
+ * - member: the member that was marked
+ * - from: the index mark() returned for it
+ *
+ * returns:
+ * - void, but after the method finishes, the member and the one it was swapped with will be back in place
+*/
+void Partition::unmark(uint64_t member, uint64_t from)
+{
+    uint64_t target = position[member];
+    uint64_t other = elements[from];
+    elements[from] = member;
+    elements[target] = other;
+    position[other] = target;
+    position[member] = from;
+}
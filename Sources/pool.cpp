@@ -0,0 +1,98 @@
+/* Array-Generator by Isaac Jung
+Last updated 10/16/2026
+
+|===========================================================================================================|
+|   This file contains definitions for methods belonging to the Pool class declared in pool.h.              |
+|===========================================================================================================|
+*/
+
+#include "pool.h"
+
+/* CONSTRUCTOR - initializes the object
+ * - overloaded: this is the default with no parameters; all jobs are done by the caller
+*/
+Pool::Pool()
+{
+    work = nullptr;
+    num_jobs = 0;
+    next = 0;
+    busy = 0;
+    batch = 0;
+    stopping = false;
+}
+
+/* CONSTRUCTOR - initializes the object
+ * - overloaded: this version starts helper threads, which sleep until run() is called
+ *
+ * parameters:
+ * - num_workers: how many workers should do jobs, counting the thread that calls run(); 0 is treated as 1
+*/
+Pool::Pool(uint64_t num_workers) : Pool::Pool()
+{
+    for (uint64_t worker = 1; worker < num_workers; worker++)
+        threads.emplace_back(&Pool::serve, this, worker);
+}
+
+/* SUB METHOD: run - does a batch of jobs using every worker, including the calling thread
+ * - jobs are handed out in increasing order, but may finish in any order
+ * - must not be called from inside a job
+ *
+ * parameters:
+ * - num_jobs: how many jobs there are; they are numbered 0 to num_jobs-1
+ * - job: what to do for each job; calls made at the same time always have different worker numbers
+ *
+ * returns:
+ * - void, but after the method finishes, every job will have been done
+*/
+void Pool::run(uint64_t num_jobs_o, const Job &job)
+{
+    std::unique_lock<std::mutex> guard(lock);
+    work = &job;
+    num_jobs = num_jobs_o;
+    next = 0;
+    busy = threads.size();
+    batch++;
+    guard.unlock();
+    wake.notify_all();
+
+    drain(0);
+    guard.lock();
+    done.wait(guard, [this] { return busy == 0; });
+    work = nullptr;
+}
+
+/* HELPER METHOD: serve - waits for batches of jobs and helps with them, until the pool is destroyed
+*/
+void Pool::serve(uint64_t worker)
+{
+    uint64_t seen = 0;  // last batch this thread helped with
+    std::unique_lock<std::mutex> guard(lock);
+    while (true) {
+        wake.wait(guard, [this, seen] { return stopping || batch != seen; });
+        if (stopping) return;
+        seen = batch;
+        guard.unlock();
+        drain(worker);
+        guard.lock();
+        if (--busy == 0) done.notify_one();
+    }
+}
+
+/* HELPER METHOD: drain - takes the next job number until there are none left, doing each job taken
+*/
+void Pool::drain(uint64_t worker)
+{
+    for (uint64_t job = next++; job < num_jobs; job = next++) (*work)(job, worker);
+}
+
+/* DECONSTRUCTOR - stops and joins the threads
+*/
+Pool::~Pool()
+{
+    {
+        std::lock_guard<std::mutex> guard(lock);
+        stopping = true;
+    }
+    wake.notify_all();
+    for (std::thread &thread : threads) thread.join();
+}
@@ -0,0 +1,143 @@
+/* Array-Generator by Isaac Jung
+Last updated 10/16/2026
+
+|===========================================================================================================|
+|   This file contains definitions for methods belonging to the Rng class declared in rng.h. See that       |
+| header for a description of the generator and its streams.                                                |
+|===========================================================================================================|
+*/
+
+#include "rng.h"
+#include "checkpoint.h"
+
+// method forward declarations
+static uint64_t rotate(uint64_t x, int k);
+
+/* CONSTRUCTOR - initializes the object
+*/
+Rng::Rng()
+{
+    seed(0);
+}
+
+/* CONSTRUCTOR - initializes the object
+ * - overloaded: this version starts the first stream of the given seed
+*/
+Rng::Rng(uint64_t s)
+{
+    seed(s);
+}
+
+/* SUB METHOD: operator() - draws the next number of the stream (xoshiro256**)
+ *
+ * returns:
+ * - a random value from 0 to UINT64_MAX
+*/
+Rng::result_type Rng::operator()()
+{
+    uint64_t result = rotate(state[1]*5, 7)*9;
+    uint64_t shifted = state[1] << 17;
+    state[2] ^= state[0];
+    state[3] ^= state[1];
+    state[1] ^= state[2];
+    state[0] ^= state[3];
+    state[2] ^= shifted;
+    state[3] = rotate(state[3], 45);
+    return result;
+}
+
+/* SUB METHOD: below - draws a random value less than a bound, every value being equally likely
+ * - the lowest 2^64 mod n numbers are redrawn, so that the rest divide evenly among the n values
+ *
+ * parameters:
+ * - n: the bound; must not be 0
+ *
+ * returns:
+ * - a random value from 0 to n-1
+*/
+uint64_t Rng::below(uint64_t n)
+{
+    uint64_t threshold = (0 - n) % n;   // 2^64 mod n
+    uint64_t x;
+    do x = (*this)(); while (x < threshold);
+    return x % n;
+}
+
+/* SUB METHOD: seed - starts the first stream of a seed
+ * - the state is filled by splitmix64, which never leaves it all zeros
+ *
+ * parameters:
+ * - s: the seed; any value is fine
+ *
+ * returns:
+ * - void, but after the method finishes, the numbers drawn will be those of the seed's first stream
+*/
+void Rng::seed(uint64_t s)
+{
+    for (uint64_t &word : state) {
+        s += 0x9E3779B97F4A7C15;
+        uint64_t z = s;
+        z = (z ^ (z >> 30))*0xBF58476D1CE4E5B9;
+        z = (z ^ (z >> 27))*0x94D049BB133111EB;
+        word = z ^ (z >> 31);
+    }
+}
+
+/* SUB METHOD: jump - skips ahead to the next stream
+ * - equivalent to drawing 2^128 numbers, so no stream will ever run into the next one
+ *
+ * returns:
+ * - void, but after the method finishes, the numbers drawn will be those of the next stream
+*/
+void Rng::jump()
+{
+    static const uint64_t JUMP[4] = {0x180EC6D33CFD0ABA, 0xD5A61266F0C9392C, 0xA9582618E03FC9AA,
+        0x39ABDC4529B1661C};
+    uint64_t jumped[4] = {0, 0, 0, 0};
+    for (uint64_t word : JUMP) {
+        for (int b = 0; b < 64; b++) {
+            if (word & static_cast<uint64_t>(1) << b)
+                for (int i = 0; i < 4; i++) jumped[i] ^= state[i];
+            (*this)();
+        }
+    }
+    for (int i = 0; i < 4; i++) state[i] = jumped[i];
+}
+
+/* SUB METHOD: save - writes the state into a checkpoint
+ * 
+ * parameters:
+ * - out: the checkpoint being written
+ * 
+ * returns:
+ * - void, but after the method finishes, the checkpoint will end with the state
+*/
+void Rng::save(Writer *out) const
+{
+    for (uint64_t word : state) out->integer(word);
+}
+
+/* SUB METHOD: load - reads back a state written by save()
+ * 
+ * parameters:
+ * - in: the checkpoint being read
+ * 
+ * returns:
+ * - true if the state was read, false if the checkpoint ended first or held a state that cannot occur
+*/
+bool Rng::load(Reader *in)
+{
+    uint64_t words[4];
+    for (uint64_t &word : words) if (!in->integer(&word)) return false;
+    if ((words[0] | words[1] | words[2] | words[3]) == 0) return false;    // would only ever draw 0
+    for (int i = 0; i < 4; i++) state[i] = words[i];
+    return true;
+}
+
+// ==============================   LOCAL HELPER METHODS BELOW THIS POINT   ============================== //
+
+// rotates the bits of a word left by k places, 0 < k < 64
+static uint64_t rotate(uint64_t x, int k)
+{
+    return (x << k) | (x >> (64 - k));
+}
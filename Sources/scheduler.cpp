@@ -0,0 +1,275 @@
+/* Array-Generator by Isaac Jung
+Last updated 10/16/2026
+
+|===========================================================================================================|
+|   This file contains definitions for methods belonging to the Scheduler class declared in scheduler.h.    |
+| See that header for a description of how heuristics are measured.                                         |
+|===========================================================================================================|
+*/
+
+#include "scheduler.h"
+#include "checkpoint.h"
+#include <limits>
+
+// a duel this quick costs next to nothing, however quick the favorite is; about a tenth of a second's work
+const double Scheduler::QUICK = 2e7;
+
+// enough to see past the noise of a few rows
+const double Scheduler::MARGIN = 1.05;
+
+/* CONSTRUCTOR - initializes the object
+*/
+Scheduler::Scheduler()
+{
+    for (uint64_t mode = 0; mode < NUM_MODES; mode++) {
+        gains[mode] = 0;
+        spent[mode] = 0;
+        last_row[mode] = 0;
+        last_elapsed[mode] = 0;
+        last_score[mode] = 0;
+    }
+    row_price = 6e9;
+    favorite = none;
+    stalled = false;
+    rows = 0;
+    elapsed = 0;
+}
+
+/* SUB METHOD: record - notes what a row built by the favorite alone achieved
+ *
+ * parameters:
+ * - heuristic: the heuristic that built the row
+ * - before: the Array's score before the row was added; should not be 0
+ * - after: the Array's score after the row was added
+ * - work: work done building the row
+ *
+ * returns:
+ * - void, but after the method finishes, the heuristic's measurements will include the row
+*/
+void Scheduler::record(prop_mode heuristic, uint64_t before, uint64_t after, double row_work)
+{
+    stalled = add_sample(heuristic, before, after, row_work).gain <= 0;
+}
+
+/* SUB METHOD: duel - notes what the rows built by a challenger and the favorite from the same state achieved
+ * - the challenger's oldest duel is forgotten once it has more than DUELS of them
+ *
+ * parameters:
+ * - challenger: the heuristic that built a row to compare with the favorite's
+ * - before: the Array's score before either row was added; should not be 0
+ * - challenger_after: what the score would have been had the challenger's row been added
+ * - challenger_work: work done building the challenger's row
+ * - favorite_after: what the score would have been had the favorite's row been added
+ * - favorite_work: work done building the favorite's row
+ *
+ * returns:
+ * - void, but after the method finishes, the measurements of both heuristics will include the duel
+*/
+void Scheduler::duel(prop_mode challenger, uint64_t before, uint64_t challenger_after, double challenger_work,
+    uint64_t favorite_after, double favorite_work)
+{
+    std::deque<Duel> &match = matches[challenger];
+    match.push_back({add_sample(challenger, before, challenger_after, challenger_work),
+        add_sample(favorite, before, favorite_after, favorite_work)});
+    if (match.size() > DUELS) match.pop_front();
+    stalled = match.back().favorite.gain <= 0;
+    last_row[challenger] = rows;
+    last_elapsed[challenger] = elapsed;
+    last_score[challenger] = before;
+}
+
+/* SUB METHOD: choose - picks the favorite for the next row, and whether some other heuristic should duel it
+ * - the challenger with the largest advantage becomes the favorite if that advantage is more than MARGIN;
+ *   every duel is then forgotten, since they were all measured against the old favorite
+ * - the first eligible heuristic becomes the favorite if the current one is no longer eligible
+ * - of the heuristics due for a duel, the one whose last duel was longest ago is the challenger
+ *
+ * parameters:
+ * - eligible: the heuristics worth considering given what is left to solve; must not be empty
+ * - score: the Array's current score
+ * - challenger: pointer to set to the heuristic that should duel the favorite on the next row, or none
+ *
+ * returns:
+ * - the favorite
+*/
+prop_mode Scheduler::choose(const std::vector<prop_mode> &eligible, uint64_t score, prop_mode *challenger)
+{
+    rows++;
+    prop_mode next = eligible[0];
+    for (prop_mode h : eligible) if (h == favorite) next = favorite;
+    if (next == favorite) {
+        double best = MARGIN;   // the advantage to beat
+        for (prop_mode h : eligible) {
+            if (h == favorite || matches[h].empty() || advantage(h) <= best) continue;
+            next = h;
+            best = advantage(h);
+        }
+    }
+    if (next != favorite) {
+        favorite = next;
+        for (uint64_t mode = 0; mode < NUM_MODES; mode++) matches[mode].clear();
+    }
+
+    *challenger = none;
+    for (prop_mode h : eligible) {
+        if (h == favorite || !due(h, score)) continue;
+        if (*challenger == none || last_row[h] < last_row[*challenger]) *challenger = h;
+    }
+    return favorite;
+}
+
+/* SUB METHOD: save - writes everything measured into a checkpoint
+ * 
+ * parameters:
+ * - out: the checkpoint being written
+ * 
+ * returns:
+ * - void, but after the method finishes, the checkpoint will end with the measurements
+*/
+void Scheduler::save(Writer *out) const
+{
+    for (uint64_t mode = 0; mode < NUM_MODES; mode++) {
+        out->integer(windows[mode].size());
+        for (const Sample &sample : windows[mode]) {
+            out->real(sample.gain);
+            out->real(sample.work);
+        }
+        out->real(gains[mode]);
+        out->real(spent[mode]);
+        out->integer(matches[mode].size());
+        for (const Duel &match : matches[mode]) {
+            out->real(match.challenger.gain);
+            out->real(match.challenger.work);
+            out->real(match.favorite.gain);
+            out->real(match.favorite.work);
+        }
+        out->integer(last_row[mode]);
+        out->real(last_elapsed[mode]);
+        out->integer(last_score[mode]);
+    }
+    out->integer(favorite);
+    out->integer(stalled);
+    out->integer(rows);
+    out->real(elapsed);
+}
+
+/* SUB METHOD: load - reads back the measurements written by save()
+ * 
+ * parameters:
+ * - in: the checkpoint being read
+ * 
+ * returns:
+ * - true if the measurements were read, false if the checkpoint ended first or held impossible ones; the
+ *   scheduler should not be used then
+*/
+bool Scheduler::load(Reader *in)
+{
+    uint64_t count, value;
+    for (uint64_t mode = 0; mode < NUM_MODES; mode++) {
+        if (!in->integer(&count) || count > WINDOW) return false;
+        windows[mode].resize(count);
+        for (Sample &sample : windows[mode])
+            if (!in->real(&sample.gain) || !in->real(&sample.work)) return false;
+        if (!in->real(&gains[mode]) || !in->real(&spent[mode])) return false;
+        if (!in->integer(&count) || count > DUELS) return false;
+        matches[mode].resize(count);
+        for (Duel &match : matches[mode]) {
+            if (!in->real(&match.challenger.gain) || !in->real(&match.challenger.work) ||
+                !in->real(&match.favorite.gain) || !in->real(&match.favorite.work)) return false;
+        }
+        if (!in->integer(&last_row[mode]) || !in->real(&last_elapsed[mode]) || !in->integer(&last_score[mode]))
+            return false;
+    }
+    if (!in->integer(&value) || value >= NUM_MODES) return false;
+    favorite = static_cast<prop_mode>(value);
+    if (!in->integer(&value) || value > 1) return false;
+    stalled = value == 1;
+    return in->integer(&rows) && in->real(&elapsed);
+}
+
+/* UTILITY METHOD: gain_per_row - average gain of the heuristic's remembered rows
+ *
+ * returns:
+ * - the average, or 0 if nothing is remembered
+*/
+double Scheduler::gain_per_row(prop_mode heuristic) const
+{
+    if (windows[heuristic].empty()) return 0;
+    return gains[heuristic]/windows[heuristic].size();
+}
+
+/* UTILITY METHOD: gain_per_work - gain of the heuristic's remembered rows per unit of work done on them
+ *
+ * returns:
+ * - the rate, or 0 if nothing is remembered
+*/
+double Scheduler::gain_per_work(prop_mode heuristic) const
+{
+    if (windows[heuristic].empty()) return 0;
+    if (spent[heuristic] <= 0) return gains[heuristic];     // as if one unit, since nothing was looked at
+    return gains[heuristic]/spent[heuristic];
+}
+
+/* UTILITY METHOD: advantage - how many times as efficient as the favorite a challenger was over its duels
+ * - each row costs the work done on it plus row_price
+ *
+ * returns:
+ * - the ratio of the challenger's efficiency to the favorite's, or 1 if it has no duels
+*/
+double Scheduler::advantage(prop_mode heuristic) const
+{
+    double gained[2] = {0, 0};  // challenger's, then favorite's
+    double cost[2] = {0, 0};
+    for (const Duel &d : matches[heuristic]) {
+        gained[0] += d.challenger.gain;
+        cost[0] += d.challenger.work + row_price;
+        gained[1] += d.favorite.gain;
+        cost[1] += d.favorite.work + row_price;
+    }
+    if (gained[1] <= 0) return gained[0] > 0 ? std::numeric_limits<double>::infinity() : 1;
+    return (gained[0]/cost[0])/(gained[1]/cost[1]);
+}
+
+/* UTILITY METHOD: due - checks whether a heuristic should be given another duel with the favorite
+ *
+ * parameters:
+ * - score: the Array's current score
+ *
+ * returns:
+ * - true if it has no duels with the current favorite, if the favorite has stalled, or if the work done since
+ *   its last duel, plus QUICK, is at least what its next row is expected to take; false otherwise
+*/
+bool Scheduler::due(prop_mode heuristic, uint64_t score) const
+{
+    if (matches[heuristic].empty() || stalled) return true;
+    double expected = spent[heuristic]/windows[heuristic].size()*score/last_score[heuristic];
+    return elapsed - last_elapsed[heuristic] + QUICK >= expected;
+}
+
+/* HELPER METHOD: add_sample - adds a row to a heuristic's window
+ * - the heuristic's oldest row is forgotten once it has more than WINDOW of them
+ *
+ * parameters:
+ * - heuristic: the heuristic that built the row
+ * - before: the Array's score before the row was added; should not be 0
+ * - after: what the score is, or would have been, after the row was added
+ * - work: work done building the row
+ *
+ * returns:
+ * - the sample added
+*/
+Sample Scheduler::add_sample(prop_mode heuristic, uint64_t before, uint64_t after, double row_work)
+{
+    Sample sample = {before > after ? static_cast<double>(before - after)/before : 0, row_work};
+    std::deque<Sample> &window = windows[heuristic];
+    window.push_back(sample);
+    gains[heuristic] += sample.gain;
+    spent[heuristic] += sample.work;
+    if (window.size() > WINDOW) {
+        gains[heuristic] -= window.front().gain;
+        spent[heuristic] -= window.front().work;
+        window.pop_front();
+    }
+    elapsed += sample.work;
+    return sample;
+}
@@ -0,0 +1,135 @@
+/* Array-Generator by Isaac Jung
+Last updated 10/16/2026
+
+|===========================================================================================================|
+|   This file contains definitions for methods belonging to the Selector class declared in selector.h. See  |
+| that header for a description of how candidates are chosen.                                               |
+|===========================================================================================================|
+*/
+
+#include "selector.h"
+
+// method forward declarations
+static bool better(const Candidate &a, const Candidate &b);
+static uint64_t mix(uint64_t x);
+
+/* CONSTRUCTOR - initializes the object
+*/
+Selector::Selector()
+{
+    capacity = 1;
+    salt = 0;
+}
+
+/* SUB METHOD: reset - forgets every candidate kept, to start a new search
+ *
+ * parameters:
+ * - capacity: how many candidates to keep at most; should be at least 1
+ * - salt: random value mixed into the tie-breaking keys; Selectors that will be merged must share it
+ *
+ * returns:
+ * - void, but after the method finishes, the Selector will be empty
+*/
+void Selector::reset(uint64_t capacity_o, uint64_t salt_o)
+{
+    capacity = capacity_o;
+    salt = salt_o;
+    kept.clear();
+}
+
+/* SUB METHOD: offer - considers a candidate for keeping
+ * - costs O(capacity) when the candidate is kept, and O(1) when it is not
+ *
+ * parameters:
+ * - score: the candidate's score
+ * - index: the candidate's index; must be different for every candidate offered in the same search
+ *
+ * returns:
+ * - true if the candidate is now among those kept, false otherwise
+*/
+bool Selector::offer(int64_t score, uint64_t index)
+{
+    if (score < threshold()) return false;
+    Candidate candidate = {score, mix(salt ^ index), index, std::vector<int>()};
+    if (!admits(candidate)) return false;
+    keep(candidate);
+    return true;
+}
+
+/* SUB METHOD: offer - considers a candidate that is a row for keeping
+ * - overloaded: this version is for candidates too many to number; the tie-breaking key is a hash of the
+ *   row's cells instead, and the cells are only copied if the candidate is kept
+ * - two different rows get the same key with probability about 2^-64, which is the only way the outcome can
+ *   depend on the order the candidates were offered in
+ *
+ * parameters:
+ * - score: the candidate's score
+ * - row: the candidate row; must be different for every candidate offered in the same search
+ * - length: number of cells in the row
+ *
+ * returns:
+ * - true if the candidate is now among those kept, false otherwise
+*/
+bool Selector::offer(int64_t score, const int *row, uint64_t length)
+{
+    if (score < threshold()) return false;
+    uint64_t key = salt;
+    for (uint64_t idx = 0; idx < length; idx++) key = mix(key + static_cast<uint64_t>(row[idx]) + 1);
+    Candidate candidate = {score, key, 0, std::vector<int>()};
+    if (!admits(candidate)) return false;
+    candidate.cells.assign(row, row + length);
+    keep(candidate);
+    return true;
+}
+
+/* SUB METHOD: merge - offers every candidate kept by another Selector to this one
+ * - the other Selector must have been reset with the same salt, so its keys can be compared as they are
+*/
+void Selector::merge(const Selector &other)
+{
+    for (const Candidate &candidate : other.kept) if (admits(candidate)) keep(candidate);
+}
+
+/* UTILITY METHOD: admits - checks whether a candidate would be kept if it was offered
+ *
+ * returns:
+ * - true if there is room for it, or it beats the worst candidate kept; false otherwise
+*/
+bool Selector::admits(const Candidate &candidate) const
+{
+    return kept.size() < capacity || better(candidate, kept.back());
+}
+
+/* HELPER METHOD: keep - slots a candidate into place among those kept, dropping the worst if there is no room
+ * - costs O(capacity); capacities are expected to be small
+ *
+ * parameters:
+ * - candidate: the candidate to keep; admits() must allow it
+ *
+ * returns:
+ * - void, but after the method finishes, the candidate will be among those kept
+*/
+void Selector::keep(const Candidate &candidate)
+{
+    if (kept.size() == capacity) kept.pop_back();
+    uint64_t pos = kept.size();
+    kept.push_back(candidate);
+    for (; pos > 0 && better(candidate, kept[pos-1]); pos--) kept[pos] = kept[pos-1];  // slide worse ones back
+    kept[pos] = candidate;
+}
+
+// ==============================   LOCAL HELPER METHODS BELOW THIS POINT   ============================== //
+
+// whether candidate a beats candidate b
+static bool better(const Candidate &a, const Candidate &b)
+{
+    return a.score > b.score || (a.score == b.score && a.key < b.key);
+}
+
+// scrambles a value (this is the finalizer of splitmix64, which maps distinct inputs to distinct outputs)
+static uint64_t mix(uint64_t x)
+{
+    x = (x ^ (x >> 30))*0xbf58476d1ce4e5b9;
+    x = (x ^ (x >> 27))*0x94d049bb133111eb;
+    return x ^ (x >> 31);
+}
@@ -0,0 +1,112 @@
+/* Array-Generator by Isaac Jung
+Last updated 10/16/2026
+
+|===========================================================================================================|
+|   This file contains definitions for methods belonging to the Separation class declared in separation.h. |
+| See that header for a description of how the counters are laid out.                                      |
+|===========================================================================================================|
+*/
+
+#include "separation.h"
+
+/* CONSTRUCTOR - initializes the object
+ * - overloaded: this is the default with no parameters; it stores no counters
+*/
+Separation::Separation()
+{
+    cap = 0;
+    num_sets = 0;
+    width = 64; per_word = 1; stride = 0;
+    mask = ~static_cast<uint64_t>(0);
+    full = 0;
+}
+
+/* CONSTRUCTOR - initializes the object
+ * - overloaded: this version allocates a counter for every (Interaction, T set) pair, all starting at 0
+ *  --> padding slots at the end of each Interaction's run start saturated
+ *
+ * parameters:
+ * - num_interactions: how many Interactions there are
+ * - num_sets: how many T sets there are
+ * - delta: the desired separation; counters saturate here
+*/
+Separation::Separation(uint64_t num_interactions, uint64_t num_sets_o, uint64_t delta) : Separation::Separation()
+{
+    cap = delta;
+    num_sets = num_sets_o;
+    width = 1;
+    while (width < 64 && (cap >> width) != 0) width *= 2;   // smallest power of 2 bits that can hold δ
+    per_word = 64/width;
+    stride = (num_sets + per_word - 1)/per_word;
+    mask = width == 64 ? ~static_cast<uint64_t>(0) : (static_cast<uint64_t>(1) << width) - 1;
+    full = 0;
+    for (uint64_t slot = 0; slot < per_word; slot++) full |= cap << (slot*width);
+    words.assign(num_interactions*stride, 0);
+    uint64_t used = num_sets % per_word;
+    if (used != 0)  // padding slots should never need looking at
+        for (uint64_t i = 0; i < num_interactions; i++)
+            for (uint64_t slot = used; slot < per_word; slot++)
+                words[i*stride + stride - 1] |= cap << (slot*width);
+}
+
+/* UTILITY METHOD: get - reads the separation of an Interaction from a T set
+ *
+ * returns:
+ * - the separation, or the cap if it is at least the cap
+*/
+uint64_t Separation::get(uint64_t interaction, uint64_t t_set) const
+{
+    return words[interaction*stride + t_set/per_word] >> (t_set % per_word*width) & mask;
+}
+
+/* SUB METHOD: saturate - sets a counter to the cap, so that it is treated as having enough separation
+*/
+void Separation::saturate(uint64_t interaction, uint64_t t_set)
+{
+    uint64_t &word = words[interaction*stride + t_set/per_word];
+    uint64_t shift = t_set % per_word*width;
+    word = (word & ~(mask << shift)) | cap << shift;
+}
+
+/* SUB METHOD: advance - records that an Interaction occurred in a new row
+ * - every T set not in the new row gets one more row of separation from the Interaction
+ *
+ * parameters:
+ * - interaction: rank of the Interaction that occurred in the new row
+ * - skip: bits set for the ranks of the T sets that also occurred in the new row
+ * - reached: set to the number of counters that reached the cap during this call
+ * - lowest: set to the smallest separation the Interaction has left from any T set; the cap if none is short
+ * - journal: where the old value of each changed word is saved, in case the row is rolled back
+ *
+ * returns:
+ * - the number of counters that changed; each such change solves one detection issue per Single involved
+*/
+uint64_t Separation::advance(uint64_t interaction, const Bitset &skip, uint64_t *reached, uint64_t *lowest,
+    Journal *journal)
+{
+    uint64_t changed = 0;
+    *reached = 0;
+    *lowest = cap;
+    uint64_t *run = &words[interaction*stride];
+    for (uint64_t w = 0; w < stride; w++) {
+        uint64_t word = run[w];
+        if (word == full) continue; // everything here is already separated enough
+        for (uint64_t slot = 0; slot < per_word; slot++) {
+            uint64_t shift = slot*width;
+            uint64_t value = word >> shift & mask;
+            if (value >= cap) continue;
+            if (skip.test(w*per_word + slot)) {
+                if (value < *lowest) *lowest = value;
+                continue;
+            }
+            word += static_cast<uint64_t>(1) << shift;  // cannot carry, since value < cap <= mask
+            if (value + 1 < *lowest) *lowest = value + 1;
+            changed++;
+            if (value + 1 == cap) (*reached)++;
+        }
+        if (word == run[w]) continue;
+        journal->save(&run[w]);
+        run[w] = word;
+    }
+    return changed;
+}
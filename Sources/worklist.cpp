@@ -0,0 +1,293 @@
+/* Array-Generator by Isaac Jung
+Last updated 10/16/2026
+
+|===========================================================================================================|
+|   This file contains definitions for methods belonging to the Worklist and SparseWorklist classes, which  |
+| are declared in worklist.h. See that header for a description of how members are filed. The methods of a  |
+| SparseWorklist follow those of a Worklist and differ only in how the buckets are found.                   |
+|===========================================================================================================|
+*/
+
+#include "worklist.h"
+#include "checkpoint.h"
+
+/* CONSTRUCTOR - initializes the object
+*/
+Worklist::Worklist()
+{
+    count = 0;
+    highest = 0;
+}
+
+/* CONSTRUCTOR - initializes the object
+ * - overloaded: this version can set its fields based on a premade number of members
+ * - every member starts out present, with key 0
+*/
+Worklist::Worklist(uint64_t n)
+{
+    buckets.resize(1);
+    buckets[0].resize(n);
+    key_of.assign(n, 0);
+    position.resize(n);
+    for (uint64_t member = 0; member < n; member++) {
+        buckets[0][member] = member;
+        position[member] = member;
+    }
+    count = n;
+    highest = 0;
+}
+
+/* SUB METHOD: insert - files a member under a key
+ *
+ * parameters:
+ * - member: the member to file; must be less than the number of members given to the constructor
+ * - key: the key to file it under
+ *
+ * returns:
+ * - void, but after the method finishes, the member will be present with the given key
+*/
+void Worklist::insert(uint64_t member, uint64_t key)
+{
+    if (key_of[member] == key) return;
+    remove(member);
+    if (key >= buckets.size()) buckets.resize(key + 1);
+    if (key > highest) highest = key;
+    key_of[member] = key;
+    position[member] = buckets[key].size();
+    buckets[key].push_back(member);
+    count++;
+}
+
+/* SUB METHOD: remove - takes a member out of the worklist
+ *
+ * parameters:
+ * - member: the member to remove
+ *
+ * returns:
+ * - void, but after the method finishes, the member will not be present
+*/
+void Worklist::remove(uint64_t member)
+{
+    if (key_of[member] == ABSENT) return;
+    std::vector<uint64_t> &bucket = buckets[key_of[member]];
+    uint64_t last = bucket.back();  // fill the hole with the bucket's last member
+    bucket[position[member]] = last;
+    position[last] = position[member];
+    bucket.pop_back();
+    key_of[member] = ABSENT;
+    count--;
+}
+
+/* SUB METHOD: top - finds the largest key that any present member has
+ *
+ * returns:
+ * - the key, or 0 if no members are present
+*/
+uint64_t Worklist::top()
+{
+    while (highest > 0 && buckets[highest].empty()) highest--;
+    return highest;
+}
+
+/* SUB METHOD: random - picks one of the members with a given key, uniformly at random
+ *
+ * parameters:
+ * - key: the key to pick from; at least one present member must have it
+ * - rng: where to get the random number from
+ *
+ * returns:
+ * - the member picked
+*/
+uint64_t Worklist::random(uint64_t key, Rng *rng) const
+{
+    const std::vector<uint64_t> &bucket = buckets[key];
+    return bucket[rng->below(bucket.size())];
+}
+
+/* SUB METHOD: save - writes every nonempty bucket into a checkpoint, keeping the order of its members
+ * - the order matters, since random() picks a member by its place in its bucket
+ *
+ * parameters:
+ * - out: the checkpoint being written
+ *
+ * returns:
+ * - void, but after the method finishes, the checkpoint will end with the buckets
+*/
+void Worklist::save(Writer *out) const
+{
+    uint64_t nonempty = 0;
+    for (const std::vector<uint64_t> &bucket : buckets) if (!bucket.empty()) nonempty++;
+    out->integer(nonempty);
+    for (uint64_t key = 0; key < buckets.size(); key++) {
+        if (buckets[key].empty()) continue;
+        out->integer(key);
+        out->integer(buckets[key].size());
+        for (uint64_t member : buckets[key]) out->integer(member);
+    }
+}
+
+/* SUB METHOD: load - replaces every bucket with those written by save()
+ *
+ * parameters:
+ * - in: the checkpoint being read
+ *
+ * returns:
+ * - true if the buckets were read, false if the checkpoint ended first or held members that are out of range
+ *   or filed twice; the worklist should not be used then
+*/
+bool Worklist::load(Reader *in)
+{
+    uint64_t n = key_of.size(), nonempty, key, size, member;
+    buckets.clear();
+    key_of.assign(n, static_cast<uint64_t>(ABSENT));   // copied, since assign() takes a reference
+    count = 0;
+    highest = 0;
+    if (!in->integer(&nonempty)) return false;
+    for (uint64_t b = 0; b < nonempty; b++) {
+        if (!in->integer(&key) || key >= n*64 + 64 || !in->integer(&size) || size > n - count) return false;
+        if (key >= buckets.size()) buckets.resize(key + 1);
+        if (key > highest) highest = key;
+        for (uint64_t idx = 0; idx < size; idx++) {
+            if (!in->integer(&member) || member >= n || key_of[member] != ABSENT) return false;
+            key_of[member] = key;
+            position[member] = buckets[key].size();
+            buckets[key].push_back(member);
+            count++;
+        }
+    }
+    return true;
+}
+
+/* CONSTRUCTOR - initializes the object
+*/
+SparseWorklist::SparseWorklist()
+{
+    count = 0;
+}
+
+/* CONSTRUCTOR - initializes the object
+ * - overloaded: this version can set its fields based on a premade number of members
+ * - every member starts out present, with key 0
+*/
+SparseWorklist::SparseWorklist(uint64_t n)
+{
+    key_of.assign(n, 0);
+    position.resize(n);
+    if (n > 0) {
+        std::vector<uint64_t> &bucket = buckets[0];
+        bucket.resize(n);
+        for (uint64_t member = 0; member < n; member++) {
+            bucket[member] = member;
+            position[member] = member;
+        }
+    }
+    count = n;
+}
+
+/* SUB METHOD: insert - files a member under a key
+ *
+ * parameters:
+ * - member: the member to file; must be less than the number of members given to the constructor
+ * - key: the key to file it under
+ *
+ * returns:
+ * - void, but after the method finishes, the member will be present with the given key
+*/
+void SparseWorklist::insert(uint64_t member, uint64_t key)
+{
+    if (key_of[member] == key) return;
+    remove(member);
+    std::vector<uint64_t> &bucket = buckets[key];
+    key_of[member] = key;
+    position[member] = bucket.size();
+    bucket.push_back(member);
+    count++;
+}
+
+/* SUB METHOD: remove - takes a member out of the worklist
+ *
+ * parameters:
+ * - member: the member to remove
+ *
+ * returns:
+ * - void, but after the method finishes, the member will not be present
+*/
+void SparseWorklist::remove(uint64_t member)
+{
+    if (key_of[member] == Worklist::ABSENT) return;
+    std::map<uint64_t, std::vector<uint64_t>>::iterator found = buckets.find(key_of[member]);
+    std::vector<uint64_t> &bucket = found->second;
+    uint64_t last = bucket.back();  // fill the hole with the bucket's last member
+    bucket[position[member]] = last;
+    position[last] = position[member];
+    bucket.pop_back();
+    if (bucket.empty()) buckets.erase(found);   // so that the largest key in use stays at hand
+    key_of[member] = Worklist::ABSENT;
+    count--;
+}
+
+/* SUB METHOD: random - picks one of the members with a given key, uniformly at random
+ *
+ * parameters:
+ * - key: the key to pick from; at least one present member must have it
+ * - rng: where to get the random number from
+ *
+ * returns:
+ * - the member picked
+*/
+uint64_t SparseWorklist::random(uint64_t key, Rng *rng) const
+{
+    const std::vector<uint64_t> &bucket = buckets.at(key);
+    return bucket[rng->below(bucket.size())];
+}
+
+/* SUB METHOD: save - writes every bucket into a checkpoint, keeping the order of its members
+ * - the order matters, since random() picks a member by its place in its bucket
+ *
+ * parameters:
+ * - out: the checkpoint being written
+ *
+ * returns:
+ * - void, but after the method finishes, the checkpoint will end with the buckets
+*/
+void SparseWorklist::save(Writer *out) const
+{
+    out->integer(buckets.size());
+    for (const std::pair<const uint64_t, std::vector<uint64_t>> &bucket : buckets) {
+        out->integer(bucket.first);
+        out->integer(bucket.second.size());
+        for (uint64_t member : bucket.second) out->integer(member);
+    }
+}
+
+/* SUB METHOD: load - replaces every bucket with those written by save()
+ *
+ * parameters:
+ * - in: the checkpoint being read
+ *
+ * returns:
+ * - true if the buckets were read, false if the checkpoint ended first or held members that are out of range
+ *   or filed twice; the worklist should not be used then
+*/
+bool SparseWorklist::load(Reader *in)
+{
+    uint64_t n = key_of.size(), num_buckets, key, size, member;
+    buckets.clear();
+    key_of.assign(n, static_cast<uint64_t>(Worklist::ABSENT));
+    count = 0;
+    if (!in->integer(&num_buckets)) return false;
+    for (uint64_t b = 0; b < num_buckets; b++) {
+        if (!in->integer(&key) || key == Worklist::ABSENT || !in->integer(&size) || size == 0 || size > n - count)
+            return false;
+        std::vector<uint64_t> &bucket = buckets[key];
+        if (!bucket.empty()) return false;
+        for (uint64_t idx = 0; idx < size; idx++) {
+            if (!in->integer(&member) || member >= n || key_of[member] != Worklist::ABSENT) return false;
+            key_of[member] = key;
+            position[member] = bucket.size();
+            bucket.push_back(member);
+            count++;
+        }
+    }
+    return true;
+}